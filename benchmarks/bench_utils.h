@@ -0,0 +1,112 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// Timing, heap allocation counting and JSON reporting shared by the benchmarks.
+// It replaces the global operator new, so include it into one translation unit per executable.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace bench {
+inline std::atomic<std::size_t>& allocationsNumber() {
+    static std::atomic<std::size_t> allocations{0};
+    return allocations;
+}
+}
+
+void* operator new(std::size_t size) {
+    ++bench::allocationsNumber();
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace bench {
+struct Result {
+    std::string name;
+    std::vector<std::pair<std::string, double>> params;
+    std::size_t iterations;
+    double nsPerOp;
+    double allocationsPerOp;
+};
+
+template <typename F>
+Result measure(const std::string& name, std::size_t iterations, F f) {
+    f(); // warm up
+    std::size_t allocations = allocationsNumber();
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+        f();
+    auto elapsed = std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(
+        std::chrono::steady_clock::now() - start);
+    allocations = allocationsNumber() - allocations;
+    Result result;
+    result.name = name;
+    result.iterations = iterations;
+    result.nsPerOp = elapsed.count() / iterations;
+    result.allocationsPerOp = static_cast<double>(allocations) / iterations;
+    return result;
+}
+
+// Like measure(), for calls that only do their work when spaced out: sleeps for gap before each call and
+// times the calls alone.
+template <typename F>
+Result measureSpaced(const std::string& name, std::size_t iterations, std::chrono::nanoseconds gap, F f) {
+    std::this_thread::sleep_for(gap);
+    f(); // warm up
+    std::size_t allocations = 0;
+    std::chrono::nanoseconds elapsed{0};
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::this_thread::sleep_for(gap);
+        std::size_t before = allocationsNumber();
+        auto start = std::chrono::steady_clock::now();
+        f();
+        elapsed += std::chrono::steady_clock::now() - start;
+        allocations += allocationsNumber() - before;
+    }
+    Result result;
+    result.name = name;
+    result.iterations = iterations;
+    result.nsPerOp = static_cast<double>(elapsed.count()) / iterations;
+    result.allocationsPerOp = static_cast<double>(allocations) / iterations;
+    return result;
+}
+
+inline void writeJson(std::ostream& out, const std::vector<std::pair<std::string, double>>& context,
+                      const std::vector<Result>& results) {
+    out << "{\n  \"context\": {";
+    for (std::size_t i = 0; i < context.size(); ++i)
+        out << (i ? ", " : "") << '"' << context[i].first << "\": " << context[i].second;
+    out << "},\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        out << "    {\"name\": \"" << result.name << "\", \"params\": {";
+        for (std::size_t j = 0; j < result.params.size(); ++j)
+            out << (j ? ", " : "") << '"' << result.params[j].first << "\": " << result.params[j].second;
+        out << "}, \"iterations\": " << result.iterations
+            << ", \"ns_per_op\": " << result.nsPerOp
+            << ", \"ops_per_second\": " << (result.nsPerOp > 0 ? 1e9 / result.nsPerOp : 0)
+            << ", \"allocations_per_op\": " << result.allocationsPerOp << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+}
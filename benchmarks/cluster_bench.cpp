@@ -0,0 +1,190 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// Measures how many samples a ClusterCollector ingests on its one receiving thread, by itself and with many
+// agents sending over loopback UDP and a Unix socket, and reports it as JSON:
+//     cluster_bench [output.json]
+// It exits with 1 if frames are lost or malformed, or the collector doesn't see every host and device.
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "monitors/cluster.h"
+#include "bench_utils.h"
+
+namespace {
+const std::size_t agentsNumber = 64;
+const std::size_t framesPerAgent = 2000;
+// the agents together offer this many samples per second, each on its own schedule
+const double offeredRate = 384000;
+
+// The devices of a node: name and cores
+const std::pair<const char*, std::size_t> devices[] = {{"CPU", 16}, {"GPU", 1}, {"NPU", 1}, {"Disk", 4},
+                                                       {"Network", 2}, {"Cgroup", 1}};
+
+void appendNode(ov::monitor::ClusterAgent& agent, std::size_t tick) {
+    double load[16];
+    for (const auto& device : devices) {
+        for (std::size_t core = 0; core < device.second; ++core)
+            load[core] = static_cast<double>((tick + core) % 100) / 100;
+        agent.append(device.first, load, device.second);
+    }
+}
+
+std::size_t samplesPerTick() {
+    return sizeof(devices) / sizeof(devices[0]);
+}
+
+bool failed = false;
+
+void check(bool condition, const std::string& name, const std::string& what) {
+    if (!condition) {
+        std::cerr << name << ": " << what << std::endl;
+        failed = true;
+    }
+}
+
+// What every run has to end with, whatever its speed.
+void checkCollector(const std::string& name, const ov::monitor::ClusterCollector& collector) {
+    ov::monitor::ClusterCollector::Stats stats = collector.getStats();
+    check(stats.malformedFrames == 0, name, std::to_string(stats.malformedFrames) + " malformed frames");
+    check(collector.getHosts().size() == agentsNumber, name,
+          std::to_string(collector.getHosts().size()) + " hosts instead of " + std::to_string(agentsNumber));
+    std::vector<ov::monitor::ClusterCollector::FleetLoad> fleet = collector.getFleetLoad();
+    check(fleet.size() == samplesPerTick(), name,
+          std::to_string(fleet.size()) + " fleet devices instead of " + std::to_string(samplesPerTick()));
+}
+
+// Frames as the agents encode them, captured on a plain socket.
+std::vector<std::vector<char>> captureFrames(std::size_t hosts) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        throw std::runtime_error("Can't bind a capture socket");
+    }
+    std::string endpoint = "udp://127.0.0.1:" + std::to_string(ntohs(address.sin_port));
+    std::vector<std::vector<char>> frames;
+    for (std::size_t host = 0; host < hosts; ++host) {
+        ov::monitor::ClusterAgent agent{endpoint, "node-" + std::to_string(host)};
+        appendNode(agent, host);
+        agent.flush();
+        char frame[65536];
+        ssize_t size = recv(fd, frame, sizeof(frame), 0);
+        if (size <= 0)
+            throw std::runtime_error("A frame is lost on loopback");
+        frames.emplace_back(frame, frame + size);
+    }
+    close(fd);
+    return frames;
+}
+
+bench::Result measureLoopback(const std::string& name, const std::string& endpoint) {
+    ov::monitor::ClusterCollector collector{endpoint};
+    collector.start();
+    std::string target = collector.getEndpoint();
+    std::atomic<std::uint64_t> dropped{0};
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> agents;
+    for (std::size_t i = 0; i < agentsNumber; ++i) {
+        agents.emplace_back([&, i] {
+            ov::monitor::ClusterAgent agent{target, "node-" + std::to_string(i)};
+            auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(agentsNumber * samplesPerTick() / offeredRate));
+            // spread the agents over the period, like nodes that started at different times
+            auto deadline = start + period * i / agentsNumber;
+            for (std::size_t tick = 0; tick < framesPerAgent; ++tick) {
+                std::this_thread::sleep_until(deadline);
+                appendNode(agent, tick);
+                agent.flush();
+                deadline += period;
+            }
+            dropped += agent.getDroppedFrames();
+        });
+    }
+    for (std::thread& agent : agents)
+        agent.join();
+    // wait until the collector drains its queue
+    ov::monitor::ClusterCollector::Stats stats = collector.getStats();
+    auto end = std::chrono::steady_clock::now();
+    while (true) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        ov::monitor::ClusterCollector::Stats next = collector.getStats();
+        if (next.frames == stats.frames)
+            break;
+        stats = next;
+        end = std::chrono::steady_clock::now();
+    }
+    collector.stop();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::vector<ov::monitor::ClusterCollector::FleetLoad> fleet = collector.getFleetLoad();
+    checkCollector(name, collector);
+    check(dropped == 0, name, std::to_string(dropped) + " frames dropped by the agents");
+    check(stats.lostFrames == 0, name, std::to_string(stats.lostFrames) + " frames lost");
+    check(stats.frames == agentsNumber * framesPerAgent, name,
+          std::to_string(stats.frames) + " frames received instead of " + std::to_string(agentsNumber * framesPerAgent));
+
+    bench::Result result;
+    result.name = name;
+    result.iterations = static_cast<std::size_t>(stats.frames);
+    result.nsPerOp = stats.frames ? seconds * 1e9 / stats.frames : 0;
+    result.allocationsPerOp = 0;
+    result.params = {{"agents", static_cast<double>(agentsNumber)},
+                     {"hosts", static_cast<double>(collector.getHosts().size())},
+                     {"fleet_devices", static_cast<double>(fleet.size())},
+                     {"offered_samples_per_second", offeredRate},
+                     {"samples_per_second", stats.samples / seconds},
+                     {"sent_frames", static_cast<double>(agentsNumber * framesPerAgent - dropped)},
+                     {"dropped_frames", static_cast<double>(dropped)},
+                     {"lost_frames", static_cast<double>(stats.lostFrames)},
+                     {"malformed_frames", static_cast<double>(stats.malformedFrames)}};
+    return result;
+}
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<bench::Result> results;
+    std::vector<std::pair<std::string, double>> context = {
+        {"agents", static_cast<double>(agentsNumber)}, {"frames_per_agent", static_cast<double>(framesPerAgent)},
+        {"samples_per_frame", static_cast<double>(samplesPerTick())},
+        {"hardware_concurrency", static_cast<double>(std::thread::hardware_concurrency())}};
+
+    // merging alone, on the calling thread
+    std::vector<std::vector<char>> frames = captureFrames(agentsNumber);
+    ov::monitor::ClusterCollector collector{"udp://127.0.0.1:0"};
+    std::size_t next = 0;
+    bench::Result ingest = bench::measure("cluster_ingest", 1000000, [&] {
+        const std::vector<char>& frame = frames[next++ % frames.size()];
+        collector.ingest(frame.data(), frame.size());
+    });
+    ingest.params = {{"hosts", static_cast<double>(collector.getHosts().size())},
+                     {"frame_bytes", static_cast<double>(frames[0].size())},
+                     {"samples_per_second", samplesPerTick() * 1e9 / ingest.nsPerOp}};
+    results.push_back(ingest);
+    checkCollector("cluster_ingest", collector);
+
+    results.push_back(measureLoopback("cluster_loopback_udp", "udp://127.0.0.1:0"));
+    std::string path = "/tmp/cluster_bench." + std::to_string(getpid()) + ".sock";
+    results.push_back(measureLoopback("cluster_loopback_unix", "unix://" + path));
+
+    if (argc > 1) {
+        std::ofstream out{argv[1]};
+        bench::writeJson(out, context, results);
+    } else {
+        bench::writeJson(std::cout, context, results);
+    }
+    return failed ? 1 : 0;
+}
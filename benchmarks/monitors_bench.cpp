@@ -0,0 +1,264 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// Measures the cost of the library itself and reports it as JSON:
+//     monitors_bench [output.json]
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "monitors/cpu_performance_counter.h"
+#include "monitors/device_monitor.h"
+#include "monitors/disk_performance_counter.h"
+#include "monitors/instrumentation.h"
+#include "monitors/network_performance_counter.h"
+#include "monitors/replay_performance_counter.h"
+#include "monitors/sample_recording.h"
+#include "monitors/shared_snapshot.h"
+#include "monitors/static_monitor.h"
+#include "bench_utils.h"
+
+namespace {
+const std::size_t nCores = sysconf(_SC_NPROCESSORS_CONF);
+const long clockTicks = sysconf(_SC_CLK_TCK);
+const std::size_t framesNumber = 1024;
+
+std::string makeTempPath() {
+    char path[] = "/tmp/monitors_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        throw std::runtime_error("mkstemp() failed");
+    }
+    close(fd);
+    return path;
+}
+
+// Random loads of `cores` cores 100 ms apart.
+std::string makeLoadRecording(std::size_t cores) {
+    std::string path = makeTempPath();
+    ov::monitor::SampleRecorder recorder{path, ov::monitor::SampleKind::LOAD, cores};
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<double> distribution{0.0, 1.0};
+    std::vector<double> load(cores);
+    for (std::size_t frame = 0; frame < framesNumber; ++frame) {
+        for (double& value : load)
+            value = distribution(generator);
+        recorder.write(std::chrono::milliseconds{100 * frame}, load.data());
+    }
+    return path;
+}
+
+// Idle jiffies of `cores` cores 500 ms apart, so every sample passes the CPU counter rate limit.
+std::string makeJiffiesRecording(std::size_t cores) {
+    std::string path = makeTempPath();
+    ov::monitor::SampleRecorder recorder{path, ov::monitor::SampleKind::IDLE_JIFFIES, cores, clockTicks};
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<unsigned long long> distribution(0, clockTicks / 2);
+    std::vector<unsigned long long> jiffies(cores);
+    for (std::size_t frame = 0; frame < framesNumber; ++frame) {
+        for (unsigned long long& value : jiffies)
+            value += distribution(generator);
+        recorder.write(std::chrono::milliseconds{500 * frame}, jiffies.data());
+    }
+    return path;
+}
+
+// Fills constant values without any I/O, so only the cost of the monitor itself is measured.
+// Without a static width StaticMonitor sizes its slice at runtime.
+template <std::size_t Cores, bool StaticWidth>
+class SyntheticPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    static constexpr std::size_t width = StaticWidth ? Cores : 0;
+
+    SyntheticPerformanceCounter() : ov::monitor::PerformanceCounter("Synthetic") {}
+
+    std::vector<double> getLoad() override {
+        return std::vector<double>(Cores, 0.5);
+    }
+
+    ov::monitor::SampleInfo sample(double* load, std::size_t capacity) override {
+        ov::monitor::SampleInfo info;
+        info.size = Cores;
+        if (capacity < Cores) {
+            info.status = ov::monitor::SampleInfo::BUFFER_TOO_SMALL;
+            return info;
+        }
+        std::fill(load, load + Cores, 0.5);
+        info.status = ov::monitor::SampleInfo::OK;
+        return info;
+    }
+};
+
+template <std::size_t Cores, bool StaticWidth>
+constexpr std::size_t SyntheticPerformanceCounter<Cores, StaticWidth>::width;
+
+// The same counter behind DeviceMonitor (shared_ptr, virtual sample(), locking, history) and StaticMonitor.
+template <std::size_t Cores>
+void measureTick(std::vector<bench::Result>& results, volatile double& sink) {
+    ov::monitor::DeviceMonitor deviceMonitor{std::make_shared<SyntheticPerformanceCounter<Cores, true>>()};
+    bench::Result device = bench::measure("device_monitor_tick", 1000000, [&] {
+        deviceMonitor.collectData();
+    });
+    ov::monitor::StaticMonitor<SyntheticPerformanceCounter<Cores, true>> staticMonitor;
+    bench::Result fixed = bench::measure("static_monitor_tick", 1000000, [&] {
+        sink = sink + staticMonitor.tick();
+    });
+    ov::monitor::StaticMonitor<SyntheticPerformanceCounter<Cores, false>> dynamicMonitor;
+    bench::Result dynamic = bench::measure("static_monitor_tick_runtime_width", 1000000, [&] {
+        sink = sink + dynamicMonitor.tick();
+    });
+    for (bench::Result* result : {&device, &fixed, &dynamic}) {
+        result->params.push_back({"cores", static_cast<double>(Cores)});
+        results.push_back(*result);
+    }
+}
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<bench::Result> results;
+    std::vector<std::string> recordings;
+    volatile double sink = 0;
+
+    {
+        ov::monitor::CpuPerformanceCounter cpuCounter;
+        // calls spaced beyond the 300 ms rate limit read /proc/stat and compute the loads
+        bench::Result result = bench::measureSpaced("cpu_counter_get_load", 10, std::chrono::milliseconds{310}, [&] {
+            std::vector<double> load = cpuCounter.getLoad();
+            sink = sink + load.size();
+        });
+        result.params.push_back({"cores", static_cast<double>(nCores)});
+        results.push_back(result);
+        std::vector<double> buffer(nCores);
+        bench::Result sample = bench::measureSpaced("cpu_counter_sample", 10, std::chrono::milliseconds{310}, [&] {
+            sink = sink + cpuCounter.sample(buffer.data(), buffer.size()).size;
+        });
+        sample.params.push_back({"cores", static_cast<double>(nCores)});
+        results.push_back(sample);
+        // back-to-back calls only reach the rate limit and return no data
+        bench::Result gated = bench::measure("cpu_counter_get_load_gated", 2000, [&] {
+            std::vector<double> load = cpuCounter.getLoad();
+            sink = sink + load.size();
+        });
+        gated.params.push_back({"cores", static_cast<double>(nCores)});
+        results.push_back(gated);
+        bench::Result sampleGated = bench::measure("cpu_counter_sample_gated", 2000, [&] {
+            sink = sink + cpuCounter.sample(buffer.data(), buffer.size()).size;
+        });
+        sampleGated.params.push_back({"cores", static_cast<double>(nCores)});
+        results.push_back(sampleGated);
+    }
+
+    {
+        // both are meant to be sampled at 100 Hz next to the CPU counter, calls closer than 5 ms have no data
+        const std::chrono::milliseconds period{10};
+        ov::monitor::NetworkPerformanceCounter networkCounter;
+        results.push_back(bench::measureSpaced("network_counter_get_load", 300, period, [&] {
+            std::vector<double> load = networkCounter.getLoad();
+            sink = sink + load.size();
+        }));
+        ov::monitor::DiskPerformanceCounter diskCounter;
+        results.push_back(bench::measureSpaced("disk_counter_get_load", 300, period, [&] {
+            std::vector<double> load = diskCounter.getLoad();
+            sink = sink + load.size();
+        }));
+        std::vector<double> buffer(256);
+        results.push_back(bench::measureSpaced("network_counter_sample", 300, period, [&] {
+            sink = sink + networkCounter.sample(buffer.data(), buffer.size()).size;
+        }));
+        results.push_back(bench::measureSpaced("disk_counter_sample", 300, period, [&] {
+            sink = sink + diskCounter.sample(buffer.data(), buffer.size()).size;
+        }));
+        // the cost of the phase timers against network_counter_sample with instrumentation disabled
+        ov::monitor::Instrumentation::setEnabled(true);
+        results.push_back(bench::measureSpaced("network_counter_sample_instrumented", 300, period, [&] {
+            sink = sink + networkCounter.sample(buffer.data(), buffer.size()).size;
+        }));
+        ov::monitor::Instrumentation::setEnabled(false);
+    }
+
+    const std::size_t coresNumbers[] = {1, 8, 64, 192};
+    const unsigned historySizes[] = {1, 16, 256, 4096};
+    for (std::size_t cores : coresNumbers) {
+        recordings.push_back(makeLoadRecording(cores));
+        for (unsigned historySize : historySizes) {
+            ov::monitor::DeviceMonitor monitor{
+                std::make_shared<ov::monitor::ReplayPerformanceCounter>(recordings.back()), historySize};
+            bench::Result collect = bench::measure("device_monitor_collect_data", 20000, [&] {
+                monitor.collectData();
+            });
+            bench::Result mean = bench::measure("device_monitor_get_mean_device_load", 20000, [&] {
+                std::vector<double> load = monitor.getMeanDeviceLoad();
+                sink = sink + load[0];
+            });
+            for (bench::Result* result : {&collect, &mean}) {
+                result->params.push_back({"cores", static_cast<double>(cores)});
+                result->params.push_back({"history_size", static_cast<double>(historySize)});
+                results.push_back(*result);
+            }
+        }
+
+        ov::monitor::ReplayPerformanceCounter loadReplay{recordings.back()};
+        bench::Result loadResult = bench::measure("replay_load_throughput", 100000, [&] {
+            std::vector<double> load = loadReplay.getLoad();
+            sink = sink + load.size();
+        });
+        loadResult.params.push_back({"cores", static_cast<double>(cores)});
+        results.push_back(loadResult);
+
+        recordings.push_back(makeJiffiesRecording(cores));
+        ov::monitor::ReplayPerformanceCounter jiffiesReplay{recordings.back()};
+        bench::Result jiffiesResult = bench::measure("replay_cpu_jiffies_throughput", 100000, [&] {
+            std::vector<double> load = jiffiesReplay.getLoad();
+            sink = sink + load.size();
+        });
+        jiffiesResult.params.push_back({"cores", static_cast<double>(cores)});
+        results.push_back(jiffiesResult);
+    }
+    for (const std::string& path : recordings)
+        std::remove(path.c_str());
+
+    for (std::size_t cores : coresNumbers) {
+        const std::string name = "/monitors_bench_" + std::to_string(getpid());
+        ov::monitor::SnapshotPublisher publisher{name, 1, cores, 16};
+        ov::monitor::SnapshotReader reader{name};
+        ov::monitor::LoadHistory history{16, cores};
+        std::vector<double> load(cores, 0.5);
+        history.push(load.data());
+        bench::Result publish = bench::measure("snapshot_publish", 100000, [&] {
+            publisher.publish(0, "CPU", history);
+        });
+        ov::monitor::SnapshotReader::Snapshot snapshot;
+        bench::Result read = bench::measure("snapshot_read", 100000, [&] {
+            sink = sink + reader.read(0, snapshot);
+        });
+        bench::Result readHistory = bench::measure("snapshot_read_with_history", 100000, [&] {
+            sink = sink + reader.read(0, snapshot, true);
+        });
+        for (bench::Result* result : {&publish, &read, &readHistory}) {
+            result->params.push_back({"cores", static_cast<double>(cores)});
+            results.push_back(*result);
+        }
+    }
+
+    measureTick<1>(results, sink);
+    measureTick<8>(results, sink);
+    measureTick<64>(results, sink);
+    measureTick<192>(results, sink);
+
+    std::vector<std::pair<std::string, double>> context = {
+        {"host_cores", static_cast<double>(nCores)}, {"clock_ticks", static_cast<double>(clockTicks)}};
+    if (argc > 1) {
+        std::ofstream out{argv[1]};
+        bench::writeJson(out, context, results);
+    } else {
+        bench::writeJson(std::cout, context, results);
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// Compares the allocation-free /proc/stat parser with the regex based reader
+// CpuPerformanceCounter used before.
+
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "monitors/proc_stat_parser.h"
+#include "bench_utils.h"
+
+namespace {
+const std::size_t nCores = sysconf(_SC_NPROCESSORS_CONF);
+
+std::vector<unsigned long> getIdleCpuStatRegex() {
+    std::vector<unsigned long> idleCpuStat(nCores);
+    std::ifstream procStat("/proc/stat");
+    std::string line;
+    std::smatch match;
+    std::regex coreJiffies("^cpu(\\d+)\\s+"
+        "(\\d+)\\s+"
+        "(\\d+)\\s+"
+        "(\\d+)\\s+"
+        "(\\d+)\\s+" // idle
+        "(\\d+)"); // iowait
+
+    while (std::getline(procStat, line)) {
+        if (std::regex_search(line, match, coreJiffies)) {
+            unsigned long idleInfo = stoul(match[5]) + stoul(match[6]),
+                coreId = stoul(match[1]);
+            if (nCores <= coreId) {
+                throw std::runtime_error("The number of cores has changed");
+            }
+            idleCpuStat[coreId] = idleInfo;
+        }
+    }
+    return idleCpuStat;
+}
+
+void print(const bench::Result& result) {
+    std::cout << result.name << ": " << result.nsPerOp / 1000 << " us/sample, "
+        << result.allocationsPerOp << " allocations/sample" << std::endl;
+}
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 2000;
+    std::cout << "Number of cores: " << nCores << "\tIterations: " << iterations << std::endl;
+
+    volatile unsigned long long sink = 0;
+    print(bench::measure("regex", iterations, [&] {
+        std::vector<unsigned long> idleCpuStat = getIdleCpuStatRegex();
+        sink = sink + idleCpuStat[0];
+    }));
+    ov::monitor::ProcStatParser procStat{nCores};
+    print(bench::measure("pread", iterations, [&] {
+        procStat.update();
+        sink = sink + procStat.getIdleJiffies(0);
+    }));
+    return 0;
+}
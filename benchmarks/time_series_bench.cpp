@@ -0,0 +1,128 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// Measures the size and the speed of the compressed time series storage and reports it as JSON:
+//     time_series_bench [output.json]
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "monitors/time_series.h"
+#include "bench_utils.h"
+
+namespace {
+const std::size_t samplesNumber = 36000;  // an hour at 10 Hz
+const std::chrono::milliseconds period{100};
+
+std::string makeTempPath() {
+    char path[] = "/tmp/time_series_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        throw std::runtime_error("mkstemp() failed");
+    }
+    close(fd);
+    return path;
+}
+
+std::size_t fileSize(const std::string& path) {
+    struct stat fileStat;
+    return stat(path.c_str(), &fileStat) == 0 ? static_cast<std::size_t>(fileStat.st_size) : 0;
+}
+
+// Per core loads like the CPU counter reports them: a random walk in [0, 1] with the percent resolution
+// and a few ms of jitter of the sampling time.
+class LoadGenerator {
+public:
+    explicit LoadGenerator(std::size_t cores) : load(cores, 0.5), generator{42} {}
+
+    const double* next() {
+        std::uniform_int_distribution<int> step(-5, 5);
+        for (double& value : load)
+            value = std::min(1.0, std::max(0.0, std::round(value * 100 + step(generator)) / 100));
+        return load.data();
+    }
+
+    std::chrono::nanoseconds nextTimestamp() {
+        std::uniform_int_distribution<int> jitter(-3, 3);
+        timestamp += period;
+        return timestamp + std::chrono::milliseconds{jitter(generator)};
+    }
+
+private:
+    std::vector<double> load;
+    std::mt19937 generator;
+    std::chrono::nanoseconds timestamp{std::chrono::hours{24 * 365 * 50}};
+};
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<bench::Result> results;
+    std::vector<std::pair<std::string, double>> context = {{"samples", static_cast<double>(samplesNumber)},
+                                                            {"period_ms", static_cast<double>(period.count())}};
+    volatile double sink = 0;
+
+    const std::size_t coresNumbers[] = {1, 8, 64, 192};
+    for (std::size_t cores : coresNumbers) {
+        std::string path = makeTempPath();
+        std::remove(path.c_str());
+        LoadGenerator generator{cores};
+        std::size_t appended = 0;
+        bench::Result append;
+        {
+            ov::monitor::TimeSeriesWriter writer{path, cores};
+            append = bench::measure("time_series_append", samplesNumber - 1, [&] {
+                writer.append(generator.nextTimestamp(), generator.next());
+                ++appended;
+            });
+        }
+        double bytesPerSample = static_cast<double>(fileSize(path)) / appended;
+
+        ov::monitor::TimeSeriesReader reader{path};
+        std::chrono::nanoseconds first = reader.getFirstTimestamp();
+        std::chrono::nanoseconds last = reader.getLastTimestamp();
+        bench::Result fullScan = bench::measure("time_series_full_scan", 10, [&] {
+            reader.scan(first, last, [&](std::chrono::nanoseconds, const double* values) {
+                sink = sink + values[0];
+            });
+        });
+        // one minute from the middle of the file
+        std::chrono::nanoseconds from = first + (last - first) / 2;
+        std::size_t rangeSamples = 0;
+        bench::Result rangeScan = bench::measure("time_series_range_scan", 100, [&] {
+            rangeSamples = reader.scan(from, from + std::chrono::minutes{1},
+                                       [&](std::chrono::nanoseconds, const double* values) {
+                sink = sink + values[0];
+            });
+        });
+
+        append.params.push_back({"bytes_per_sample", bytesPerSample});
+        append.params.push_back({"bytes_per_value", bytesPerSample / cores});
+        append.params.push_back({"raw_bytes_per_sample", static_cast<double>(8 * (cores + 1))});
+        fullScan.params.push_back({"samples_per_op", static_cast<double>(reader.getNumberOfSamples())});
+        fullScan.params.push_back({"samples_per_second",
+                                   reader.getNumberOfSamples() * 1e9 / fullScan.nsPerOp});
+        rangeScan.params.push_back({"samples_per_op", static_cast<double>(rangeSamples)});
+        rangeScan.params.push_back({"blocks", static_cast<double>(reader.getNumberOfBlocks())});
+        for (bench::Result* result : {&append, &fullScan, &rangeScan}) {
+            result->params.insert(result->params.begin(), {"cores", static_cast<double>(cores)});
+            results.push_back(*result);
+        }
+        std::remove(path.c_str());
+    }
+
+    if (argc > 1) {
+        std::ofstream out{argv[1]};
+        bench::writeJson(out, context, results);
+    } else {
+        bench::writeJson(std::cout, context, results);
+    }
+    return 0;
+}
@@ -2,30 +2,50 @@
 #include <thread>
 #include <chrono>
 #include <iomanip>
-#include "monitors/device_monitor.h"
+#include <cstdlib>
+#include "monitors/monitor_hub.h"
 #include "monitors/cpu_performance_counter.h"
 #include "monitors/gpu_performance_counter.h"
+#include "monitors/metrics_exporter.h"
+#include "monitors/cluster.h"
+// main [port] also serves the loads at http://127.0.0.1:<port>/metrics
+// main <port> <collector> also ships them to a ClusterCollector, e.g. at udp://10.0.0.1:9100
 int main(int argc, char *argv[])
 {
-    ov::monitor::DeviceMonitor cpuMonitor{std::make_shared<ov::monitor::CpuPerformanceCounter>(), 1};
-    ov::monitor::DeviceMonitor gpuMonitor{std::make_shared<ov::monitor::GpuPerformanceCounter>(), 1};
-    cpuMonitor.collectData();
-    gpuMonitor.collectData();
+    ov::monitor::MonitorHub hub{std::chrono::milliseconds{500}};
+    hub.addCounter(std::make_shared<ov::monitor::CpuPerformanceCounter>());
+    // the Windows counter sleeps in getLoad(), keep it away from the CPU one
+    hub.addCounter(std::make_shared<ov::monitor::GpuPerformanceCounter>(), true);
+    const char* names[] = {"CPU: ", "GPU: "};
+    ov::monitor::MetricsExporter exporter{static_cast<unsigned short>(argc > 1 ? std::atoi(argv[1]) : 0)};
+    exporter.addMetric("ov_cpu_load", "Load of a CPU core.", "core");
+    exporter.addMetric("ov_gpu_load", "Load of a GPU adapter.", "adapter");
+    if (argc > 1)
+        exporter.start();
+    std::unique_ptr<ov::monitor::ClusterAgent> agent;
+    if (argc > 2)
+        agent.reset(new ov::monitor::ClusterAgent{argv[2]});
+    const char* devices[] = {"CPU", "GPU"};
+    hub.setBatchCallback([&names, &exporter, &agent, &devices](const ov::monitor::MonitorHub::Batch& batch) {
+        exporter.publish(batch);
+        for (std::size_t i = 0; i < batch.samples.size(); ++i) {
+            if (batch.samples[i].status != ov::monitor::MonitorHub::Sample::OK)
+                continue;
+            if (agent)
+                agent->append(devices[i], batch.samples[i].load.data(), batch.samples[i].load.size());
+            std::cout << names[i];
+            for (auto load : batch.samples[i].load) {
+                std::cout << std::fixed << std::setprecision(2) << load * 100 << "% ";
+            }
+            std::cout << std::endl;
+        }
+        if (agent)
+            agent->flush();
+    });
+    hub.start();
     while (1)
     {
-        std::cout << "CPU: ";
-        for (auto load : cpuMonitor.getMeanDeviceLoad()) {
-            std::cout << std::fixed << std::setprecision(2) << load * 100 << "% ";
-        }
-        std::cout << std::endl;
-        cpuMonitor.collectData();
-
-        std::cout << "GPU: ";
-        for (auto load : gpuMonitor.getMeanDeviceLoad()) {
-            std::cout << std::fixed << std::setprecision(2) << load * 100 << "% ";
-        }
-        std::cout << std::endl;
-        gpuMonitor.collectData();
+        std::this_thread::sleep_for(std::chrono::seconds{1});
     }
     return 0;
-}
\ No newline at end of file
+}
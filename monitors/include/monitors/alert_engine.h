@@ -0,0 +1,127 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "performance_counter.h"
+
+namespace ov {
+namespace monitor {
+// Rule-based alerting evaluated incrementally on every new sample: each rule keeps a small state per
+// watched value (the hold timer, the previous value, EWMA mean and variance), so a sample costs
+// O(cores x rules) and the history is never rescanned. Feed it with DeviceMonitor::setAlertEngine();
+// callbacks then run on the sampling threads.
+class AlertEngine {
+public:
+    enum Scope {
+        CORE,       // every core of the device separately
+        DEVICE,     // the mean of the cores of the device
+        AGGREGATE   // the mean of the latest device means of all the devices feeding the engine, once per
+                    // round: when every device has a new sample, or one of them brings a second sample first
+    };
+
+    enum Direction {
+        ABOVE,  // the value (or its rate of change) is greater than the threshold
+        BELOW   // the value is less than the threshold, or it falls faster than the threshold
+    };
+
+    struct Alert {
+        enum State {
+            FIRING,
+            RESOLVED
+        };
+        State state;
+        std::size_t rule;
+        std::size_t device;
+        std::size_t core;     // npos unless the rule has CORE scope
+        double value;         // the load
+        double score;         // what the rule compared: the load, its rate per second or its z-score (0 when
+                              // a core disappeared and its alert is resolved with its last load)
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
+    typedef std::function<void(const Alert&)> Callback;
+
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    // Rules return their ids. The device is ignored for AGGREGATE rules. A condition has to hold for the
+    // whole hold duration before the alert fires, the alert is resolved as soon as it stops holding.
+    std::size_t addThresholdRule(const std::string& name, Scope scope, std::size_t device, double threshold,
+                                 Direction direction = ABOVE,
+                                 std::chrono::milliseconds hold = std::chrono::milliseconds{0});
+    // The change of the load per second between two consecutive samples.
+    std::size_t addRateRule(const std::string& name, Scope scope, std::size_t device, double ratePerSecond,
+                            Direction direction = ABOVE,
+                            std::chrono::milliseconds hold = std::chrono::milliseconds{0});
+    // |load - mean| / deviation over an exponentially weighted mean and variance, where alpha is the weight
+    // of a new sample. Nothing fires during the first warmup samples.
+    std::size_t addAnomalyRule(const std::string& name, Scope scope, std::size_t device, double zScore,
+                               double alpha = 0.1, std::size_t warmup = 10,
+                               std::chrono::milliseconds hold = std::chrono::milliseconds{0});
+    std::string getRuleName(std::size_t rule) const;
+    // Called for every change of an alert state, in the order they were added. Exceptions are swallowed.
+    // Callbacks may query the engine but must not add callbacks or evaluate samples.
+    void addCallback(const Callback& callback);
+    std::size_t getNumberOfFiringAlerts() const;
+
+    // A new sample of a device: cores values taken at info.timestamp.
+    void evaluate(std::size_t device, const double* load, std::size_t cores, const SampleInfo& info);
+
+private:
+    enum Kind {
+        THRESHOLD,
+        RATE,
+        ANOMALY
+    };
+
+    struct Rule {
+        std::string name;
+        Kind kind;
+        Scope scope;
+        std::size_t device;
+        double threshold;
+        Direction direction;
+        std::chrono::milliseconds hold;
+        double alpha;
+        std::size_t warmup;
+    };
+
+    // One per watched value of a rule: a core, the device or the aggregate.
+    struct State {
+        bool active = false;  // the condition holds, since `since`
+        bool firing = false;
+        std::chrono::steady_clock::time_point since;
+        std::size_t samples = 0;
+        double prevValue = 0;
+        std::chrono::steady_clock::time_point prevTimestamp;
+        double mean = 0;
+        double variance = 0;
+    };
+
+    std::size_t addRule(const Rule& rule);
+    void update(std::size_t rule, State& state, std::size_t device, std::size_t core, double value,
+                std::chrono::steady_clock::time_point timestamp);
+    // Resolves the alert of a value that isn't watched anymore.
+    void resolve(std::size_t rule, State& state, std::size_t device, std::size_t core,
+                 std::chrono::steady_clock::time_point timestamp);
+
+    mutable std::mutex mutex;
+    std::vector<Rule> rules;
+    std::vector<std::vector<State>> states;  // per rule
+    std::vector<double> deviceMeans;
+    std::vector<bool> deviceSeen;
+    std::vector<bool> deviceFresh;  // has a sample since the last aggregate update
+    std::mutex callbackMutex;
+    std::vector<Callback> callbacks;
+    std::vector<Alert> pendingAlerts;
+    std::size_t firingNumber = 0;
+};
+}
+}
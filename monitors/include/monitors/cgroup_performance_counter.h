@@ -0,0 +1,53 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "performance_counter.h"
+
+namespace ov {
+namespace monitor {
+// CPU accounting of cgroup v2 groups from cpu.stat and cpu.max, the files stay open between samples.
+// The load of a cgroup is its CPU usage relative to its quota (cpu.max), or to all CPUs without a quota,
+// so 1 means the cgroup uses everything it is allowed to and is likely throttled.
+class CgroupPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    struct CgroupStat {
+        unsigned long long usageUsec = 0;
+        unsigned long long userUsec = 0;
+        unsigned long long systemUsec = 0;
+        unsigned long long nrPeriods = 0;
+        unsigned long long nrThrottled = 0;
+        unsigned long long throttledUsec = 0;
+        double quota = 0;  // CPUs, 0 if unlimited
+    };
+
+    // Cgroups are paths relative to the cgroupfs root, e.g. /system.slice/foo.service, with or without the
+    // leading slash; no cgroups means the cgroup of the calling process.
+    CgroupPerformanceCounter(const std::vector<std::string>& cgroups = {},
+                             const std::string& cgroupfsRoot = "/sys/fs/cgroup", const std::string& procfsRoot = "/proc");
+    ~CgroupPerformanceCounter();
+    // Usage relative to the quota for every cgroup in the order of getCgroups().
+    std::vector<double> getLoad() override;
+    SampleInfo sample(double* load, std::size_t capacity) override;
+    const std::vector<std::string>& getCgroups() const;
+    // As of the last getLoad().
+    CgroupStat getStat(std::size_t cgroup);
+    // Between the last two getLoad() calls: the share of the enforcement periods the cgroup was throttled
+    // in and the throttled time per second.
+    double getThrottledPeriodsRatio(std::size_t cgroup);
+    double getThrottledTimeRatio(std::size_t cgroup);
+    // The cgroup v2 path of a process from <procfsRoot>/<pid>/cgroup.
+    static std::string getProcessCgroup(const std::string& procfsRoot = "/proc", const std::string& pid = "self");
+private:
+    std::vector<std::string> cgroups;
+    std::string cgroupfsRoot;
+    class PerformanceCounterImpl;
+    PerformanceCounterImpl* performanceCounter = NULL;
+    PerformanceCounterImpl& impl();
+};
+}
+}
@@ -0,0 +1,172 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "device_monitor.h"
+
+namespace ov {
+namespace monitor {
+// Fleet-level loads: every node runs a ClusterAgent that ships its samples to one ClusterCollector.
+// Endpoints are "udp://<IPv4>:<port>" or "unix://<path>" (datagram sockets). Samples travel in batched
+// binary frames, one datagram each, little-endian:
+//     u32 magic "OVMF", u8 version, u8 host length, host, u32 sequence, u16 samples number, then per sample
+//     u8 device length, device, u16 width, i64 system_clock timestamp in us, width x f32 loads
+// A frame holds as many samples as fit into maxFrameSize (the UDP payload of a 1500 bytes MTU by default),
+// a single sample that doesn't fit gets a frame of its own, up to the 65507 bytes of a UDP datagram. Lost
+// frames aren't resent, the collector counts them from the sequence gaps and ignores frames that arrive
+// late or twice.
+
+// append() and flush() may be called from any thread, also while the thread started by start() runs.
+class ClusterAgent {
+public:
+    // No host name means gethostname().
+    ClusterAgent(const std::string& endpoint, const std::string& hostName = "", std::size_t maxFrameSize = 1472);
+    ~ClusterAgent();
+    ClusterAgent(const ClusterAgent&) = delete;
+    ClusterAgent& operator=(const ClusterAgent&) = delete;
+
+    // Monitors are added while the agent is stopped.
+    void addMonitor(const std::shared_ptr<DeviceMonitor>& monitor, const std::string& device);
+    // Sends the pending frame first if the sample doesn't fit into it.
+    void append(const std::string& device, const double* load, std::size_t size,
+                std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now());
+    void flush();
+
+    // Every period appends the latest sample of every monitor that has a new one, then flushes. The period
+    // must be at least 1 ms.
+    void start(std::chrono::milliseconds period);
+    void stop();
+    bool isRunning() const;
+
+    const std::string& getHostName() const;
+    std::uint64_t getSentFrames() const;
+    // Frames the socket refused, e.g. because the collector is down or its queue is full.
+    std::uint64_t getDroppedFrames() const;
+
+private:
+    struct Source {
+        std::shared_ptr<DeviceMonitor> monitor;
+        std::string device;
+        std::chrono::steady_clock::time_point lastTimestamp;
+    };
+
+    void appendLocked(const std::string& device, const double* load, std::size_t size,
+                      std::chrono::system_clock::time_point timestamp);
+    void flushLocked();
+    void loop();
+
+    std::string hostName;
+    std::size_t maxFrameSize;
+    int fd = -1;
+    std::string unixPath;
+    std::vector<Source> sources;
+    std::vector<double> scratch;
+
+    mutable std::mutex mutex;
+    std::vector<char> frame;
+    std::size_t frameSamples = 0;
+    std::uint32_t sequence = 0;
+    std::uint64_t sentFrames = 0;
+    std::uint64_t droppedFrames = 0;
+
+    std::condition_variable wakeUp;
+    std::thread thread;
+    std::chrono::milliseconds period{0};
+    bool stopRequested = false;
+};
+
+// Receives the frames of many agents on one thread and keeps the latest sample of every device of every
+// host. Frames are validated first and then merged under one lock without allocating, unless a host or a
+// device shows up or a width changes. Fleet-wide aggregates are computed on query.
+class ClusterCollector {
+public:
+    struct DeviceLoad {
+        std::string device;
+        std::vector<double> load;  // the latest sample
+        double mean = 0;           // of the latest sample
+        std::uint64_t samples = 0;
+        std::chrono::system_clock::time_point timestamp;
+    };
+
+    struct HostLoad {
+        std::string host;
+        std::vector<DeviceLoad> devices;
+        std::uint64_t frames = 0;
+        std::uint64_t lostFrames = 0;
+        std::chrono::steady_clock::time_point lastSeen;
+    };
+
+    // One device name across the hosts, over the means of their latest samples.
+    struct FleetLoad {
+        std::string device;
+        std::size_t hosts = 0;
+        double mean = 0;
+        double min = 0;
+        double max = 0;
+        std::uint64_t samples = 0;
+    };
+
+    struct Stats {
+        std::uint64_t frames = 0;
+        std::uint64_t samples = 0;
+        std::uint64_t malformedFrames = 0;
+        std::uint64_t lostFrames = 0;
+        std::uint64_t reorderedFrames = 0;  // arrived late or twice, they are ignored
+    };
+
+    // Port 0 picks a free port, see getEndpoint().
+    explicit ClusterCollector(const std::string& endpoint);
+    ~ClusterCollector();
+    ClusterCollector(const ClusterCollector&) = delete;
+    ClusterCollector& operator=(const ClusterCollector&) = delete;
+
+    void start();
+    void stop();
+    bool isRunning() const;
+    std::string getEndpoint() const;
+
+    // Merges one frame, as the receiving thread does for every datagram. Returns false for a malformed one.
+    bool ingest(const char* data, std::size_t size);
+
+    std::vector<std::string> getHosts() const;
+    bool getHostLoad(const std::string& host, HostLoad& load) const;
+    std::vector<FleetLoad> getFleetLoad() const;
+    Stats getStats() const;
+    // Forgets the hosts that sent nothing for longer than timeout.
+    void expireHosts(std::chrono::milliseconds timeout);
+
+private:
+    struct Host {
+        std::vector<DeviceLoad> devices;
+        std::uint32_t sequence = 0;
+        std::uint64_t frames = 0;
+        std::uint64_t lostFrames = 0;
+        std::chrono::steady_clock::time_point lastSeen;
+    };
+
+    void receive();
+
+    std::string endpoint;
+    int fd = -1;
+    int wakeUpFds[2] = {-1, -1};
+    std::thread thread;
+    bool running = false;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Host> hosts;
+    std::string hostKey;  // lookup scratch
+    Stats stats;
+};
+}
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace ov {
+namespace monitor {
+// CPU load from idle (idle + iowait) jiffies of two samples. It is shared by the live Linux
+// CpuPerformanceCounter, StaticCpuPerformanceCounter and ReplayPerformanceCounter so recorded inputs
+// go through the same math.
+class CpuLoadCalculator {
+public:
+    CpuLoadCalculator(std::size_t nCores, long clockTicks) : clockTicks{clockTicks}, prevIdleCpuStat(nCores) {}
+
+    void reset(const unsigned long long* idleCpuStat, std::chrono::nanoseconds timePoint) {
+        std::copy(idleCpuStat, idleCpuStat + prevIdleCpuStat.size(), prevIdleCpuStat.begin());
+        prevTimePoint = timePoint;
+    }
+
+    // Returns false without updating the state if the sample is too close to the previous one.
+    bool update(const unsigned long long* idleCpuStat, std::chrono::nanoseconds timePoint, double* cpuLoad) {
+        if (!computeLoad(idleCpuStat, prevIdleCpuStat.data(), prevIdleCpuStat.size(), clockTicks,
+                         timePoint - prevTimePoint, cpuLoad))
+            return false;
+        reset(idleCpuStat, timePoint);
+        return true;
+    }
+
+    // The load of nCores cores over interval, for callers that keep the state themselves. Returns false
+    // without writing anything if the interval is too short.
+    static bool computeLoad(const unsigned long long* idleCpuStat, const unsigned long long* prevIdleCpuStat,
+                            std::size_t nCores, long clockTicks, std::chrono::nanoseconds interval, double* cpuLoad) {
+        // don't update data too frequently which may result in negative values for cpuLoad.
+        // It may happen when collectData() is called just after setHistorySize().
+        if (interval <= std::chrono::milliseconds{300})
+            return false;
+        typedef std::chrono::duration<double, std::chrono::seconds::period> Sec;
+        double elapsed = std::chrono::duration_cast<Sec>(interval).count();
+        for (std::size_t i = 0; i < nCores; ++i) {
+            double idleDiff = idleCpuStat[i] - prevIdleCpuStat[i];
+            cpuLoad[i] = 1.0 - idleDiff / clockTicks / elapsed;
+        }
+        return true;
+    }
+
+    std::size_t getNumberOfCores() const {
+        return prevIdleCpuStat.size();
+    }
+
+    const unsigned long long* getPrevIdleCpuStat() const {
+        return prevIdleCpuStat.data();
+    }
+
+    std::chrono::nanoseconds getPrevTimePoint() const {
+        return prevTimePoint;
+    }
+
+private:
+    long clockTicks;
+    std::vector<unsigned long long> prevIdleCpuStat;
+    std::chrono::nanoseconds prevTimePoint{0};
+};
+}
+}
@@ -6,6 +6,7 @@
 
 #include <deque>
 #include <memory>
+#include <string>
 #include <vector>
 #include "performance_counter.h"
 
@@ -16,6 +17,10 @@ public:
     CpuPerformanceCounter(int nCores = 0);
     ~CpuPerformanceCounter();
     std::vector<double> getLoad() override;
+    SampleInfo sample(double* load, std::size_t capacity) override;
+    // Records the raw per-core idle jiffies of every sample (and the current baseline) for ReplayPerformanceCounter.
+    void startRecording(const std::string& path);
+    void stopRecording();
 private:
     int nCores = 0;
     class PerformanceCounterImpl;
@@ -0,0 +1,38 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "performance_counter.h"
+#include "proc_stat_parser.h"
+
+namespace ov {
+namespace monitor {
+// Per-core breakdown of CPU time by /proc/stat column (user, nice, system, idle, iowait, irq, softirq, steal,
+// guest, guest_nice). All data is column-major: the values of one column for all cores are contiguous.
+// Guest time is also accounted in user/nice, so the guest ratios overlap with them.
+class CpuTimesPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    typedef ProcStatParser::Column Column;
+
+    CpuTimesPerformanceCounter();
+    ~CpuTimesPerformanceCounter();
+    // COLUMNS_NUMBER x nCores ratios of time spent in each state since the previous call,
+    // empty if no time was accounted since then.
+    std::vector<double> getLoad() override;
+    std::size_t getNumberOfCores();
+    // nCores values of the last sample returned by getLoad()
+    const unsigned long long* getDeltas(Column column);
+    const double* getRatios(Column column);
+    // ratio of the column over all cores
+    double getTotalRatio(Column column);
+private:
+    class PerformanceCounterImpl;
+    PerformanceCounterImpl* performanceCounter = NULL;
+    PerformanceCounterImpl& impl();
+};
+}
+}
@@ -0,0 +1,46 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ov {
+namespace monitor {
+// Logical CPU -> physical core -> last level cache -> NUMA node -> socket mapping, read once from
+// <sysfsRoot>/devices/system/cpu/cpu*/{topology,cache} and <sysfsRoot>/devices/system/node/node*/cpulist.
+// Domains of every level are numbered densely from 0.
+class CpuTopology {
+public:
+    enum Level {
+        CPU = 0,    // logical CPU (SMT thread)
+        CORE,       // physical core: SMT siblings
+        LLC,        // CPUs sharing the last level cache
+        NUMA_NODE,
+        SOCKET,
+        LEVELS_NUMBER
+    };
+
+    explicit CpuTopology(const std::string& sysfsRoot = "/sys");
+
+    // Highest CPU index + 1, including CPUs whose topology is unknown (e.g. offline ones).
+    std::size_t getNumberOfCpus() const;
+    std::size_t getNumberOfDomains(Level level) const;
+    // -1 if the CPU topology is unknown
+    int getDomain(Level level, std::size_t cpu) const;
+    // OS id of the domain: the CPU/NUMA node number, package id; the first CPU for cores and caches
+    int getDomainId(Level level, std::size_t domain) const;
+    // number of known CPUs in the domain
+    std::size_t getDomainSize(Level level, std::size_t domain) const;
+
+private:
+    std::size_t nCpus = 0;
+    std::vector<int> domains;  // LEVELS_NUMBER x nCpus
+    std::vector<std::vector<int>> domainIds;
+    std::vector<std::vector<std::size_t>> domainSizes;
+};
+}
+}
@@ -0,0 +1,42 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "cpu_performance_counter.h"
+#include "cpu_topology.h"
+#include "performance_counter.h"
+
+namespace ov {
+namespace monitor {
+// Aggregates per-CPU loads of the wrapped counter at every CpuTopology level. The per-domain sums
+// are updated from the changes of the per-CPU samples, consumers only read the precomputed means.
+class CpuTopologyPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    CpuTopologyPerformanceCounter(
+        const std::shared_ptr<ov::monitor::PerformanceCounter>& perCpuCounter = std::make_shared<CpuPerformanceCounter>(),
+        const std::string& sysfsRoot = "/sys");
+    // Mean loads of all domains, level after level: CPUs, cores, LLCs, NUMA nodes, sockets.
+    // getOffset() tells where a level starts, so the result of DeviceMonitor::getMeanDeviceLoad() can be sliced too.
+    std::vector<double> getLoad() override;
+    const CpuTopology& getTopology() const;
+    std::size_t getOffset(CpuTopology::Level level) const;
+    // getTopology().getNumberOfDomains(level) mean loads of the last sample
+    const double* getLoad(CpuTopology::Level level) const;
+private:
+    void resync(const std::vector<double>& cpuLoad);
+
+    const std::shared_ptr<ov::monitor::PerformanceCounter> perCpuCounter;
+    CpuTopology topology;
+    std::size_t offsets[CpuTopology::LEVELS_NUMBER + 1];
+    std::vector<double> prevCpuLoad;
+    std::vector<double> sums;
+    std::vector<double> loads;
+    unsigned updatesNumber = 0;
+};
+}
+}
@@ -4,29 +4,135 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
+#include "alert_engine.h"
+#include "instrumentation.h"
+#include "load_history.h"
 #include "performance_counter.h"
+#include "shared_snapshot.h"
 namespace ov {
 namespace monitor {
         class DeviceMonitor
         {
         public:
+            // Read-only access to the history without copying it. The view holds the monitor lock,
+            // so the sampling thread can't publish new samples while it is alive: keep it short-lived.
+            class HistoryView {
+            public:
+                HistoryView(std::unique_lock<std::mutex>&& lock, const LoadHistory& history,
+                            const SampleInfo& lastSampleInfo) :
+                    lock{std::move(lock)}, history{history}, lastSampleInfo{lastSampleInfo} {}
+                const LoadHistory& operator*() const { return history; }
+                const LoadHistory* operator->() const { return &history; }
+                // Of the latest sample in the history, read under the same lock.
+                const SampleInfo& getLastSampleInfo() const { return lastSampleInfo; }
+            private:
+                std::unique_lock<std::mutex> lock;
+                const LoadHistory& history;
+                const SampleInfo& lastSampleInfo;
+            };
+
+            // Adaptive mode: the period drops to minPeriod when the load of a core changes by more than
+            // changeThreshold between two samples or crosses one of the bands, and grows by backoff after
+            // every steady sample up to maxPeriod.
+            struct AdaptiveSampling {
+                std::chrono::milliseconds minPeriod;
+                std::chrono::milliseconds maxPeriod;
+                double changeThreshold;
+                std::vector<double> bands;  // e.g. {0.5, 0.9}
+                double backoff;
+
+                AdaptiveSampling(std::chrono::milliseconds minPeriod = std::chrono::milliseconds{100},
+                                 std::chrono::milliseconds maxPeriod = std::chrono::milliseconds{5000},
+                                 double changeThreshold = 0.1, const std::vector<double>& bands = {},
+                                 double backoff = 2) :
+                    minPeriod{minPeriod}, maxPeriod{maxPeriod}, changeThreshold{changeThreshold}, bands(bands),
+                    backoff{backoff} {}
+            };
+
             DeviceMonitor(const std::shared_ptr<ov::monitor::PerformanceCounter> &PerformanceCounter, unsigned historySize = 1);
+            // Asynchronous mode: doesn't block, samples are collected by a background thread every samplingPeriod.
+            DeviceMonitor(const std::shared_ptr<ov::monitor::PerformanceCounter> &PerformanceCounter, unsigned historySize,
+                          std::chrono::milliseconds samplingPeriod);
+            DeviceMonitor(const std::shared_ptr<ov::monitor::PerformanceCounter> &PerformanceCounter, unsigned historySize,
+                          const AdaptiveSampling& adaptiveSampling);
             ~DeviceMonitor();
             void setHistorySize(std::size_t size);
             std::size_t getHistorySize() const;
+            // Fills the history on the first call, then appends one new sample dropping the oldest one. It waits
+            // for a counter that has no data yet, giving up after a second without any.
+            // In asynchronous mode it doesn't sample but rethrows the error the sampling thread stopped with, if any.
             void collectData();
             std::deque<std::vector<double>> getLastHistory() const;
+            HistoryView getHistoryView() const;
             std::vector<double> getMeanDeviceLoad() const;
 
+            // Starts (or restarts with a new period) the sampling thread. Each tick appends one sample to the
+            // history and drops the oldest one, getters return the latest published data without sampling.
+            void startSampling(std::chrono::milliseconds samplingPeriod);
+            // Starts the sampling thread in adaptive mode, beginning with minPeriod.
+            void startSampling(const AdaptiveSampling& adaptiveSampling);
+            void stopSampling();
+            bool isSampling() const;
+            // The current period of the sampling thread, it changes over time in adaptive mode.
+            std::chrono::milliseconds getSamplingPeriod() const;
+            // Samples per second the sampling thread has actually collected over the last 5 seconds, so it
+            // follows period changes and counters that stop having data.
+            double getSamplingRate() const;
+
+            // Publisher mode: every new sample is also published as the device-th slot of the shared memory
+            // segment, so other processes read it with SnapshotReader instead of sampling themselves.
+            void setSnapshotPublisher(const std::shared_ptr<SnapshotPublisher>& publisher, std::size_t device);
+
+            // Every new sample is also evaluated by the engine as the device-th device, on the sampling thread
+            // (or in collectData()) after the history is updated and without holding the monitor lock.
+            void setAlertEngine(const std::shared_ptr<AlertEngine>& engine, std::size_t device);
+
+            // Timestamp and interval of the latest sample in the history.
+            SampleInfo getLastSampleInfo() const;
+
         private:
-            unsigned samplesNumber;
+            // No config means a fixed period.
+            void startSamplingThread(std::chrono::milliseconds period, const AdaptiveSampling* config);
+            void samplingLoop();
+            // Samples into sampleBuffer, growing it if the counter asks for more room.
+            SampleInfo takeSample();
+            void pushSample(const SampleInfo& info);
+            // Picks the period after the sample in sampleBuffer, before it is pushed into the history.
+            void adaptSamplingPeriod(const SampleInfo& info);
+
             unsigned historySize;
-            std::vector<double> deviceLoadSum;
-            std::deque<std::vector<double>> deviceLoadHistory;
+            LoadHistory deviceLoadHistory;
             const std::shared_ptr<ov::monitor::PerformanceCounter> performanceCounter;
+            CounterInstrumentation& instrumentation;
+            // only touched by the thread that samples, so it is filled without holding the lock
+            std::vector<double> sampleBuffer;
+            SampleInfo lastSampleInfo;
+
+            mutable std::mutex mutex;
+            std::condition_variable wakeUp;
+            std::thread sampler;
+            std::chrono::milliseconds samplingPeriod{0};
+            bool adaptive = false;
+            AdaptiveSampling adaptiveSampling;
+            std::chrono::steady_clock::time_point samplingStart;
+            std::deque<std::chrono::steady_clock::time_point> sampleTimes;  // within the rate window
+            bool stopRequested = false;
+            std::exception_ptr samplingError;
+            std::shared_ptr<SnapshotPublisher> snapshotPublisher;
+            std::size_t snapshotDevice = 0;
+            std::shared_ptr<AlertEngine> alertEngine;
+            std::size_t alertDevice = 0;
+            std::string deviceName;
         };
 }
-}
\ No newline at end of file
+}
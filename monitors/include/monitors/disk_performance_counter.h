@@ -0,0 +1,59 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "performance_counter.h"
+
+namespace ov {
+namespace monitor {
+// Block device I/O from /proc/diskstats, computed from the deltas between two getLoad() calls. The file
+// stays open and is parsed in place; devices are matched by position, so the device list (and the
+// filtering) is only rebuilt when a device appears or disappears.
+// The load of a device is its utilization: the share of the time it had I/O in flight. Calls less than 5 ms
+// after the previous one, or after the counter is created, have no data.
+class DiskPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    enum Filter {
+        ALL_DEVICES = 0,
+        NO_PARTITIONS = 1,  // devices missing from <sysfs>/block
+        NO_VIRTUAL = 2,     // loop and ram devices
+        DEFAULT_FILTER = NO_PARTITIONS | NO_VIRTUAL
+    };
+
+    enum Metric {
+        READ_BYTES = 0,  // per second
+        WRITE_BYTES,
+        READ_IOPS,
+        WRITE_IOPS,
+        READ_LATENCY,    // average per request, ms
+        WRITE_LATENCY,
+        UTILIZATION,
+        QUEUE_SIZE,      // average number of requests in flight
+        METRICS_NUMBER
+    };
+
+    // Devices whose names start with one of excludedPrefixes (e.g. "dm-") are skipped as well.
+    DiskPerformanceCounter(unsigned filter = DEFAULT_FILTER, const std::vector<std::string>& excludedPrefixes = {},
+                           const std::string& procfsRoot = "/proc", const std::string& sysfsRoot = "/sys");
+    ~DiskPerformanceCounter();
+    // Utilization of every device in the order of getDevices().
+    std::vector<double> getLoad() override;
+    SampleInfo sample(double* load, std::size_t capacity) override;
+    const std::vector<std::string>& getDevices();
+    // As of the last getLoad().
+    double getMetric(Metric metric, std::size_t device);
+private:
+    unsigned filter;
+    std::vector<std::string> excludedPrefixes;
+    std::string procfsRoot;
+    std::string sysfsRoot;
+    class PerformanceCounterImpl;
+    PerformanceCounterImpl* performanceCounter = NULL;
+    PerformanceCounterImpl& impl();
+};
+}
+}
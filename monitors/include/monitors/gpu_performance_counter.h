@@ -6,6 +6,7 @@
 
 #include <deque>
 #include <memory>
+#include <string>
 #include <vector>
 #include "performance_counter.h"
 
@@ -13,10 +14,17 @@ namespace ov {
 namespace monitor {
 class GpuPerformanceCounter : public ov::monitor::PerformanceCounter {
 public:
-    GpuPerformanceCounter();
+    // Linux: Intel devices are discovered under <sysfsRoot>/class/drm, the busy time of their render and compute
+    // engines is read from the DRM fdinfo of the processes in procfsRoot. Both are ignored on Windows. Without
+    // devices the load is a single 0. The fds of the processes started since are looked up every second, the
+    // fds that running processes open later every 10 seconds. Without root (CAP_SYS_PTRACE) only the processes
+    // of the same user can be read, the GPU clients of other users are missing from the load.
+    GpuPerformanceCounter(const std::string& sysfsRoot = "/sys", const std::string& procfsRoot = "/proc");
     ~GpuPerformanceCounter();
     std::vector<double> getLoad() override;
 private:
+    std::string sysfsRoot;
+    std::string procfsRoot;
     class PerformanceCounterImpl;
     PerformanceCounterImpl* performanceCounter = NULL;
 };
@@ -0,0 +1,145 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "performance_counter.h"
+
+namespace ov {
+namespace monitor {
+// Lock-free histogram with power of two buckets: bucket i counts latencies in [2^i, 2^(i+1)) ns.
+class LatencyHistogram {
+public:
+    static const std::size_t BUCKETS_NUMBER = 40;  // the last one is open-ended, from ~9 minutes
+
+    LatencyHistogram();
+    void record(std::chrono::nanoseconds latency);
+    void reset();
+    std::uint64_t getCount() const;
+    std::chrono::nanoseconds getSum() const;
+    std::chrono::nanoseconds getMax() const;
+    std::uint64_t getBucket(std::size_t bucket) const;
+    // The upper bound of the bucket the percentile (0-100) falls into.
+    std::chrono::nanoseconds getPercentile(double percentile) const;
+
+private:
+    std::atomic<std::uint64_t> buckets[BUCKETS_NUMBER];
+    std::atomic<std::uint64_t> count;
+    std::atomic<std::uint64_t> sum;
+    std::atomic<std::uint64_t> max;
+};
+
+// The cost of sampling one counter, shared by everything sampling counters with that counter name, see
+// PerformanceCounter::getCounterName().
+class CounterInstrumentation {
+public:
+    enum Phase {
+        TOTAL = 0,  // the whole sample, as seen by DeviceMonitor or MonitorHub
+        READ,       // reading the source: pread() of procfs, PdhCollectQueryData()
+        PARSE,
+        COMPUTE,    // loads and rates from the parsed values
+        PHASES_NUMBER
+    };
+
+    enum Event {
+        SAMPLES = 0,
+        NO_DATA,           // e.g. the CPU counter samples taken less than 300 ms apart
+        BUFFER_TOO_SMALL,  // retries to grow the buffer
+        ERRORS,
+        SKIPPED,           // MonitorHub ticks the counter was still busy for
+        EVENTS_NUMBER
+    };
+
+    explicit CounterInstrumentation(const std::string& name);
+    const std::string& getName() const;
+    void record(Phase phase, std::chrono::nanoseconds latency);
+    void count(Event event);
+    // CPU time of the sampling thread (of DeviceMonitor or MonitorHub) that sampled the counter last, since
+    // it started.
+    void setThreadCpuTime(std::chrono::nanoseconds cpuTime);
+
+    const LatencyHistogram& getLatency(Phase phase) const;
+    std::uint64_t getEvents(Event event) const;
+    std::chrono::nanoseconds getThreadCpuTime() const;
+    void reset();
+
+private:
+    std::string name;
+    LatencyHistogram latencies[PHASES_NUMBER];
+    std::atomic<std::uint64_t> events[EVENTS_NUMBER];
+    std::atomic<std::int64_t> threadCpuTime;
+};
+
+// Self-overhead instrumentation of the library. It is disabled by default and then costs one relaxed
+// atomic load per instrumented phase.
+class Instrumentation {
+public:
+    static void setEnabled(bool enable);
+    static bool isEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+    // Created on first use and never destroyed, so callers keep the reference.
+    static CounterInstrumentation& get(const std::string& counterName);
+    static std::vector<std::string> getCounterNames();
+    static void reset();
+    // CPU time of the calling thread, 0 where it isn't implemented.
+    static std::chrono::nanoseconds getThreadCpuTime();
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+// Records the time until the end of the scope into a phase, if instrumentation is enabled.
+class PhaseTimer {
+public:
+    PhaseTimer(CounterInstrumentation& instrumentation, CounterInstrumentation::Phase phase) :
+        instrumentation{Instrumentation::isEnabled() ? &instrumentation : nullptr}, phase{phase} {
+        if (this->instrumentation)
+            start = std::chrono::steady_clock::now();
+    }
+    ~PhaseTimer() {
+        if (instrumentation)
+            instrumentation->record(phase, std::chrono::steady_clock::now() - start);
+    }
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    CounterInstrumentation* instrumentation;
+    CounterInstrumentation::Phase phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+// The overhead of the library through the counter API: the load of an instrumented counter is the wall-clock
+// time its samples took (the sum of the TOTAL latencies) per second elapsed since the previous getLoad(), in
+// the order of getCounters(). It includes the time the sampling thread waited or was preempted, so it isn't a
+// CPU share; getThreadCpuTime() tells the CPU time. The phase latencies, the event counts and the thread CPU
+// times of the counters are available by the same index.
+class InstrumentationPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    InstrumentationPerformanceCounter();
+    std::vector<double> getLoad() override;
+    const std::vector<std::string>& getCounters() const;
+    // Events of a counter between the last two getLoad() calls, e.g. the samples without data or skipped.
+    std::uint64_t getEvents(std::size_t counter, CounterInstrumentation::Event event) const;
+    // The latencies of a phase of a counter since instrumentation was last reset.
+    const LatencyHistogram& getLatency(std::size_t counter, CounterInstrumentation::Phase phase) const;
+    // The CPU time of the thread that sampled the counter last, see CounterInstrumentation::setThreadCpuTime().
+    std::chrono::nanoseconds getThreadCpuTime(std::size_t counter) const;
+private:
+    std::vector<std::string> counters;
+    std::vector<CounterInstrumentation*> instrumentations;
+    std::vector<std::chrono::nanoseconds> prevSums;
+    std::vector<std::uint64_t> prevEvents;  // per counter and event
+    std::vector<std::uint64_t> events;
+    std::chrono::steady_clock::time_point prevTimePoint;
+};
+}
+}
@@ -0,0 +1,52 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace ov {
+namespace monitor {
+// Fixed-capacity ring buffer of per-core load samples. All samples live in one
+// cores x capacity allocation (each core's history is contiguous), running sums
+// make the sliding mean O(cores) per appended sample.
+class LoadHistory {
+public:
+    LoadHistory(std::size_t capacity = 1, std::size_t nCores = 0);
+
+    // Drops all samples and reallocates the storage.
+    void reset(std::size_t capacity, std::size_t nCores);
+    // Keeps the newest samples that fit into the new capacity.
+    void setCapacity(std::size_t capacity);
+    void clear();
+    // Appends a sample of getNumberOfCores() values, the oldest one is dropped when full.
+    void push(const double* load);
+
+    std::size_t size() const;
+    std::size_t capacity() const;
+    std::size_t getNumberOfCores() const;
+    bool full() const;
+    // sample 0 is the oldest one
+    double at(std::size_t sample, std::size_t core) const;
+    double getSum(std::size_t core) const;
+    double getMean(std::size_t core) const;
+
+    // The history of one core is stored in the ring starting at getHead():
+    // [head, capacity) are older than [0, head) once the buffer is full.
+    const double* getCoreSamples(std::size_t core) const;
+    std::size_t getHead() const;
+
+private:
+    void recomputeSums();
+
+    std::size_t historyCapacity;
+    std::size_t nCores;
+    std::size_t head = 0;  // the oldest sample
+    std::size_t count = 0;
+    std::vector<double> samples;
+    std::vector<double> sums;
+};
+}
+}
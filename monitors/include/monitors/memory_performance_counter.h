@@ -0,0 +1,67 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "performance_counter.h"
+
+namespace ov {
+namespace monitor {
+// System-wide (/proc/meminfo) and per-NUMA-node (<sysfs>/devices/system/node/node*/meminfo) memory usage
+// and memory traffic counters of /proc/vmstat. Files stay open and are re-read without allocations.
+class MemoryPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    enum MemoryField {
+        MEM_TOTAL = 0,
+        MEM_FREE,
+        MEM_AVAILABLE,  // system-wide only
+        BUFFERS,        // system-wide only
+        CACHED,         // FilePages for nodes
+        ANON_PAGES,
+        SHMEM,
+        SLAB,
+        DIRTY,
+        SWAP_TOTAL,     // system-wide only
+        SWAP_FREE,      // system-wide only
+        MEMORY_FIELDS_NUMBER
+    };
+
+    enum VmstatField {
+        PGFAULT = 0,
+        PGMAJFAULT,
+        PGPGIN,
+        PGPGOUT,
+        PSWPIN,
+        PSWPOUT,
+        NUMA_HIT,
+        NUMA_MISS,
+        NUMA_FOREIGN,
+        NUMA_LOCAL,
+        NUMA_OTHER,
+        VMSTAT_FIELDS_NUMBER
+    };
+
+    MemoryPerformanceCounter(const std::string& procfsRoot = "/proc", const std::string& sysfsRoot = "/sys");
+    ~MemoryPerformanceCounter();
+    // Used memory ratio: the system first, then every NUMA node. Nodes don't report MemAvailable, their ratios
+    // count free memory and the page cache except Shmem as available, which is close to it.
+    std::vector<double> getLoad() override;
+    std::size_t getNumberOfNodes();
+    // In bytes, as of the last getLoad(); node -1 is the whole system, other nodes throw std::out_of_range.
+    unsigned long long getValue(MemoryField field, int node = -1);
+    unsigned long long getCounter(VmstatField field);
+    // Per second between the last two getLoad() calls.
+    double getRate(VmstatField field);
+private:
+    std::string procfsRoot;
+    std::string sysfsRoot;
+    class PerformanceCounterImpl;
+    PerformanceCounterImpl* performanceCounter = NULL;
+    PerformanceCounterImpl& impl();
+};
+}
+}
@@ -0,0 +1,77 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "monitor_hub.h"
+
+namespace ov {
+namespace monitor {
+// Serves the batches of a MonitorHub in the OpenMetrics text format over HTTP:
+//     curl http://127.0.0.1:<port>/metrics
+// The whole response is rendered once per batch into a recycled buffer, a scrape only sends it.
+// Every load value of the n-th hub counter becomes a gauge sample of the n-th metric with the value
+// index as a label, e.g. ov_cpu_load{core="3"} 0.25. Samples without data are left out.
+class MetricsExporter {
+public:
+    // Port 0 picks a free port, see getPort().
+    explicit MetricsExporter(unsigned short port, const std::string& address = "127.0.0.1");
+    ~MetricsExporter();
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Describes the metric of the next hub counter, in the order of MonitorHub::addCounter().
+    // Metrics are added before the first publish().
+    void addMetric(const std::string& name, const std::string& help, const std::string& label);
+    // Renders the batch, meant to be called from MonitorHub::BatchCallback (one call at a time).
+    void publish(const MonitorHub::Batch& batch);
+    void start();
+    void stop();
+    bool isRunning() const;
+    unsigned short getPort() const;
+
+private:
+    struct Metric {
+        std::string name;
+        std::string help;
+        std::string label;
+    };
+
+    // A client served by the poll() loop of serve(), the sockets are non-blocking.
+    struct Connection {
+        int fd = -1;
+        std::chrono::steady_clock::time_point deadline;
+        char request[2048];
+        std::size_t received = 0;
+        std::shared_ptr<std::string> response;  // set once the request is in
+        std::size_t sent = 0;
+    };
+
+    void serve();
+    // Both return false once the connection is to be closed.
+    bool receiveRequest(Connection& connection);
+    bool sendResponse(Connection& connection);
+    void render(const MonitorHub::Batch& batch, std::string& out);
+
+    std::string address;
+    unsigned short port;
+    std::vector<Metric> metrics;
+    int listenFd = -1;
+    int wakeUpFds[2] = {-1, -1};
+    std::thread thread;
+    bool running = false;
+    std::string body;  // rendering scratch
+
+    mutable std::mutex mutex;
+    std::shared_ptr<std::string> response;  // the one being served
+    std::shared_ptr<std::string> spare;     // reused for the next batch once no scrape holds it
+};
+}
+}
@@ -0,0 +1,107 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "instrumentation.h"
+#include "performance_counter.h"
+
+namespace ov {
+namespace monitor {
+// Samples many counters on a shared tick. A timer thread stamps every tick with one steady_clock
+// time point and hands the counters to a small worker pool; counters registered with a dedicated
+// thread (e.g. the Windows ones that sleep in getLoad()) can't hold up the pool. A counter still busy
+// with a previous tick is skipped, and a batch is published as soon as all its samples are in, or
+// at the next tick with the missing ones marked LATE.
+class MonitorHub {
+public:
+    struct Sample {
+        enum Status {
+            OK,
+            NO_DATA,   // getLoad() returned {}
+            SKIPPED,   // the counter was still busy with a previous tick
+            LATE,      // the counter didn't finish before the next tick
+            FAILED     // getLoad() threw
+        };
+        Status status = LATE;
+        std::vector<double> load;
+    };
+
+    struct Batch {
+        std::uint64_t tick = 0;
+        std::chrono::steady_clock::time_point timestamp;
+        std::vector<Sample> samples;  // in the order of addCounter()
+    };
+
+    typedef std::function<void(const Batch&)> BatchCallback;
+
+    MonitorHub(std::chrono::milliseconds period, std::size_t workersNumber = 1);
+    ~MonitorHub();
+    MonitorHub(const MonitorHub&) = delete;
+    MonitorHub& operator=(const MonitorHub&) = delete;
+
+    // Counters and the callback can only be set while the hub is stopped.
+    std::size_t addCounter(const std::shared_ptr<ov::monitor::PerformanceCounter>& counter, bool dedicatedThread = false);
+    // Called from the hub threads for every published batch, one call at a time and in order.
+    // It must not stop the hub.
+    void setBatchCallback(const BatchCallback& callback);
+    void start();
+    void stop();
+    bool isRunning() const;
+    Batch getLastBatch() const;
+    std::chrono::milliseconds getPeriod() const;
+
+private:
+    struct Job {
+        std::size_t counter;
+        std::uint64_t tick;
+    };
+
+    struct JobQueue {
+        std::mutex mutex;
+        std::condition_variable wakeUp;
+        std::deque<Job> jobs;
+        bool stopRequested = false;
+    };
+
+    void timerLoop();
+    void workerLoop(JobQueue& queue);
+    void sample(const Job& job);
+    void publish(std::unique_lock<std::mutex>& lock);
+
+    const std::chrono::milliseconds period;
+    const std::size_t workersNumber;
+    std::vector<std::shared_ptr<ov::monitor::PerformanceCounter>> counters;
+    std::vector<CounterInstrumentation*> instrumentations;
+    std::vector<std::size_t> counterQueues;  // 0 is the shared pool
+    std::vector<std::unique_ptr<JobQueue>> queues;
+    std::vector<std::thread> threads;
+    BatchCallback callback;
+
+    mutable std::mutex mutex;
+    std::condition_variable timerWakeUp;
+    bool running = false;
+    bool stopRequested = false;
+    std::vector<bool> inFlight;
+    Batch pending;
+    bool pendingPublished = true;
+    std::size_t pendingExpected = 0;
+    std::size_t pendingCompleted = 0;
+    Batch lastBatch;
+    std::uint64_t publishedNumber = 0;
+    std::mutex callbackMutex;
+    std::condition_variable callbackTurn;
+    std::uint64_t calledNumber = 0;
+};
+}
+}
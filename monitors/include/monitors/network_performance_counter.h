@@ -0,0 +1,49 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "performance_counter.h"
+
+namespace ov {
+namespace monitor {
+// Network interface traffic from /proc/net/dev as per second rates between two getLoad() calls. All
+// interfaces come with one pread() of a persistent fd and are parsed in place; interfaces are matched by
+// position, so the interface list is only rebuilt when an interface appears or disappears.
+// The load of an interface is its received plus transmitted bytes per second. Calls less than 5 ms after the
+// previous one, or after the counter is created, have no data.
+class NetworkPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    enum Metric {
+        RX_BYTES = 0,
+        RX_PACKETS,
+        RX_ERRORS,
+        RX_DROPS,
+        TX_BYTES,
+        TX_PACKETS,
+        TX_ERRORS,
+        TX_DROPS,
+        METRICS_NUMBER
+    };
+
+    // No interfaces means all of them but the loopback one.
+    NetworkPerformanceCounter(const std::vector<std::string>& interfaces = {}, const std::string& procfsRoot = "/proc");
+    ~NetworkPerformanceCounter();
+    // Bytes per second of every interface in the order of getInterfaces().
+    std::vector<double> getLoad() override;
+    SampleInfo sample(double* load, std::size_t capacity) override;
+    const std::vector<std::string>& getInterfaces();
+    // Per second, as of the last getLoad().
+    double getRate(Metric metric, std::size_t interface);
+private:
+    std::vector<std::string> interfaces;
+    std::string procfsRoot;
+    class PerformanceCounterImpl;
+    PerformanceCounterImpl* performanceCounter = NULL;
+    PerformanceCounterImpl& impl();
+};
+}
+}
@@ -0,0 +1,59 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "performance_counter.h"
+
+namespace ov {
+namespace monitor {
+// Per-CPU perf_event counters (Linux). Every CPU has a hardware group (cycles, instructions, cache misses)
+// and a software group (task clock, context switches, migrations), each read with a single read().
+// Hardware events are usually missing in VMs and containers, then only the software group is opened.
+// Counts are scaled when the kernel multiplexes the PMU. At most half of RLIMIT_NOFILE fds are opened, the
+// events of the CPUs past that are unavailable and count 0. The load of a CPU is its IPC if cycles and
+// instructions are counted, context switches per second otherwise.
+class PerfEventPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    enum Scope {
+        // Every CPU, needs perf_event_paranoid <= 0 or CAP_PERFMON.
+        SYSTEM = 0,
+        // A single entry for the user space of this process: its main thread and the threads and processes
+        // started after the events are opened by the first call. Works with perf_event_paranoid 2.
+        PROCESS
+    };
+
+    enum Event {
+        CYCLES = 0,
+        INSTRUCTIONS,
+        CACHE_MISSES,
+        TASK_CLOCK,  // ns
+        CONTEXT_SWITCHES,
+        CPU_MIGRATIONS,
+        EVENTS_NUMBER
+    };
+
+    // Throws on the first call if no event of the scope can be opened.
+    explicit PerfEventPerformanceCounter(Scope scope = SYSTEM);
+    ~PerfEventPerformanceCounter();
+    std::vector<double> getLoad() override;
+    Scope getScope() const;
+    // CPUs whose events are reported, 1 for PROCESS.
+    std::size_t getNumberOfCpus();
+    // On every CPU, or on the given one.
+    bool isAvailable(Event event);
+    bool isAvailable(Event event, std::size_t cpu);
+    // The count between the last two getLoad() calls and its rate per second.
+    double getDelta(Event event, std::size_t cpu);
+    double getRate(Event event, std::size_t cpu);
+private:
+    Scope scope;
+    class PerformanceCounterImpl;
+    PerformanceCounterImpl* performanceCounter = NULL;
+    PerformanceCounterImpl& impl();
+};
+}
+}
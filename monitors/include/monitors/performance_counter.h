@@ -3,23 +3,75 @@
 //
 
 #pragma once
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <vector>
 #include <string>
 
 namespace ov {
 namespace monitor {
+// Describes what sample() has written. Errors are thrown as for getLoad().
+struct SampleInfo {
+    enum Status {
+        OK = 0,
+        NO_DATA,          // nothing to report yet: the sample only set the baseline or came too early
+        BUFFER_TOO_SMALL  // nothing is written, size is the capacity required; a retry with room gets the sample
+    };
+    Status status = NO_DATA;
+    std::size_t size = 0;
+    // when the counters were read, and the time the values are averaged over (0 for the first sample)
+    std::chrono::steady_clock::time_point timestamp;
+    std::chrono::nanoseconds interval{0};
+};
+
 class PerformanceCounter {
 public:
-    PerformanceCounter(std::string deviceName) {
+    // The counter name keys the instrumentation of the counter and tells apart the counters of one device,
+    // it is the device name by default.
+    PerformanceCounter(std::string deviceName, std::string counterName = "") :
+        deviceName{deviceName}, counterName{counterName.empty() ? deviceName : counterName} {
     }
+    virtual ~PerformanceCounter() = default;
     virtual std::vector<double> getLoad() = 0;
+    // Writes the same values as getLoad() into the caller's buffer. The default implementation wraps getLoad()
+    // and stamps the sample itself, counters override it to sample without allocating.
+    virtual SampleInfo sample(double* load, std::size_t capacity) {
+        // a sample that didn't fit is kept for the retry with a bigger buffer
+        if (unsentValues.empty()) {
+            unsentValues = getLoad();
+            unsentInfo = SampleInfo{};
+            unsentInfo.timestamp = std::chrono::steady_clock::now();
+            if (prevTimestamp != std::chrono::steady_clock::time_point{})
+                unsentInfo.interval = unsentInfo.timestamp - prevTimestamp;
+            prevTimestamp = unsentInfo.timestamp;
+            unsentInfo.size = unsentValues.size();
+            if (unsentValues.empty())
+                return unsentInfo;
+        }
+        SampleInfo info = unsentInfo;
+        if (unsentValues.size() > capacity) {
+            info.status = SampleInfo::BUFFER_TOO_SMALL;
+            return info;
+        }
+        std::copy(unsentValues.begin(), unsentValues.end(), load);
+        unsentValues.clear();
+        info.status = SampleInfo::OK;
+        return info;
+    }
     std::string name() {
         return deviceName;
     }
+    std::string getCounterName() {
+        return counterName;
+    }
 
 private:
     std::string deviceName;
+    std::string counterName;
+    std::chrono::steady_clock::time_point prevTimestamp;
+    std::vector<double> unsentValues;
+    SampleInfo unsentInfo;
 };
 }
-}
\ No newline at end of file
+}
@@ -0,0 +1,107 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "performance_counter.h"
+
+namespace ov {
+namespace monitor {
+// Linux Pressure Stall Information of the whole system (root is /proc/pressure) or of a cgroup v2
+// (root is the cgroup directory with cpu.pressure, io.pressure and memory.pressure). The load is the
+// share of the time between two getLoad() calls some (SOME) or all (FULL) non-idle tasks were stalled
+// on a resource: {CPU some, CPU full, IO some, IO full, MEMORY some, MEMORY full}. Missing files
+// (e.g. CPU full before Linux 5.13) report 0.
+class PressurePerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    enum Resource {
+        CPU = 0,
+        IO,
+        MEMORY,
+        RESOURCES_NUMBER
+    };
+
+    enum Scope {
+        SOME = 0,
+        FULL,
+        SCOPES_NUMBER
+    };
+
+    struct Pressure {
+        double avg10 = 0;  // percent
+        double avg60 = 0;
+        double avg300 = 0;
+        unsigned long long total = 0;  // stall time, us
+    };
+
+    explicit PressurePerformanceCounter(const std::string& root = "/proc/pressure");
+    ~PressurePerformanceCounter();
+    std::vector<double> getLoad() override;
+    // The kernel averages as of the last getLoad().
+    Pressure getPressure(Resource resource, Scope scope);
+    // The pressure file of a resource under a system or cgroup root.
+    static std::string getPath(const std::string& root, Resource resource);
+private:
+    std::string root;
+    class PerformanceCounterImpl;
+    PerformanceCounterImpl* performanceCounter = NULL;
+    PerformanceCounterImpl& impl();
+};
+
+// A PSI trigger: the kernel wakes up poll() with POLLPRI on getFd() once the stall time of the resource
+// exceeds `stall` within a sliding `window` (500 ms to 10 s, unprivileged processes need whole multiples
+// of 2 s). Nothing is polled in between, so waiting costs nothing while the system is calm.
+class PressureTrigger {
+public:
+    PressureTrigger(PressurePerformanceCounter::Resource resource, PressurePerformanceCounter::Scope scope,
+                    std::chrono::microseconds stall, std::chrono::microseconds window,
+                    const std::string& root = "/proc/pressure");
+    ~PressureTrigger();
+    PressureTrigger(const PressureTrigger&) = delete;
+    PressureTrigger& operator=(const PressureTrigger&) = delete;
+
+    int getFd() const;
+    // Returns false on timeout, a negative timeout waits forever.
+    bool wait(std::chrono::milliseconds timeout);
+
+private:
+    int fd = -1;
+};
+
+// Waits for many triggers on one thread and calls back with the index of every trigger that fired.
+class PressureWatcher {
+public:
+    typedef std::function<void(std::size_t trigger)> Callback;
+
+    PressureWatcher() = default;
+    ~PressureWatcher();
+    PressureWatcher(const PressureWatcher&) = delete;
+    PressureWatcher& operator=(const PressureWatcher&) = delete;
+
+    // Triggers and the callback can only be set while the watcher is stopped.
+    std::size_t addTrigger(const std::shared_ptr<PressureTrigger>& trigger);
+    void setCallback(const Callback& callback);
+    void start();
+    void stop();
+    bool isRunning() const;
+
+private:
+    void watch();
+
+    std::vector<std::shared_ptr<PressureTrigger>> triggers;
+    Callback callback;
+    std::thread thread;
+    int wakeUpFds[2] = {-1, -1};
+    mutable std::mutex mutex;
+    bool running = false;
+};
+}
+}
@@ -0,0 +1,64 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ov {
+namespace monitor {
+class CounterInstrumentation;
+
+// Reads per-core jiffies from /proc/stat without per-sample heap allocations.
+// The file is kept open and re-read with pread() into a reusable buffer, values
+// are stored column-major: all cores of one column are contiguous.
+class ProcStatParser {
+public:
+    enum Column {
+        USER = 0,
+        NICE,
+        SYSTEM,
+        IDLE,
+        IOWAIT,
+        IRQ,
+        SOFTIRQ,
+        STEAL,
+        GUEST,
+        GUEST_NICE,
+        COLUMNS_NUMBER
+    };
+
+    // Cores with ids from nCores on throw std::runtime_error, unless firstCoresOnly skips them.
+    ProcStatParser(std::size_t nCores, const std::string& path = "/proc/stat", bool firstCoresOnly = false);
+    ~ProcStatParser();
+    ProcStatParser(const ProcStatParser&) = delete;
+    ProcStatParser& operator=(const ProcStatParser&) = delete;
+
+    // Re-reads the file. Cores missing from the file (e.g. offline) are reported as 0.
+    void update();
+    // Times the READ and PARSE phases of update() into instrumentation, if it is enabled.
+    void setInstrumentation(CounterInstrumentation* instrumentation);
+    std::size_t getNumberOfCores() const;
+    // The highest core id in the file plus one, as of the last update(), including skipped cores.
+    std::size_t getListedCores() const;
+    const unsigned long long* getColumn(Column column) const;
+    unsigned long long getJiffies(Column column, std::size_t core) const;
+    // idle + iowait
+    unsigned long long getIdleJiffies(std::size_t core) const;
+
+private:
+    bool parse(std::size_t size);
+
+    int fd = -1;
+    CounterInstrumentation* instrumentation = nullptr;
+    std::size_t nCores;
+    bool firstCoresOnly;
+    std::size_t listedCores = 0;
+    std::vector<char> buffer;
+    std::vector<unsigned long long> jiffies;
+};
+}
+}
@@ -0,0 +1,41 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "performance_counter.h"
+
+namespace ov {
+namespace monitor {
+// CPU usage per process and, optionally, per thread from /proc/<pid>/stat and /proc/<pid>/task/<tid>/stat.
+// Processes are tracked between samples: their stat files and task directories stay open and only
+// appearing or exiting pids cause open()/close().
+class ProcessPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    struct TaskLoad {
+        int pid;
+        int tid;      // equals pid for process totals
+        double load;  // fraction of one core
+    };
+
+    // topN == 0 reports all tasks, otherwise only the topN busiest ones.
+    ProcessPerformanceCounter(bool perThread = false, std::size_t topN = 0, const std::string& procfsRoot = "/proc");
+    ~ProcessPerformanceCounter();
+    // Loads of the processes of getProcesses(), in descending order. Empty on the first call.
+    std::vector<double> getLoad() override;
+    // valid until the next getLoad()
+    const std::vector<TaskLoad>& getProcesses();
+    const std::vector<TaskLoad>& getThreads();
+private:
+    bool perThread;
+    std::size_t topN;
+    std::string procfsRoot;
+    class PerformanceCounterImpl;
+    PerformanceCounterImpl* performanceCounter = NULL;
+};
+}
+}
@@ -0,0 +1,51 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "performance_counter.h"
+#include "sample_recording.h"
+
+namespace ov {
+namespace monitor {
+// Records every non-empty sample of the wrapped counter (SampleKind::LOAD).
+class RecordingPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    RecordingPerformanceCounter(const std::shared_ptr<ov::monitor::PerformanceCounter>& performanceCounter,
+                                const std::string& path);
+    std::vector<double> getLoad() override;
+private:
+    const std::shared_ptr<ov::monitor::PerformanceCounter> performanceCounter;
+    std::unique_ptr<SampleRecorder> recorder;
+    std::size_t width = 0;
+    std::string path;
+};
+
+// Feeds a recording back. LOAD recordings return the recorded samples, IDLE_JIFFIES recordings
+// (see CpuPerformanceCounter::startRecording()) go through the same load math as the live CPU counter,
+// including empty results for samples taken too early.
+class ReplayPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    enum Speed {
+        RECORDED_SPEED,       // sleeps to reproduce the recorded intervals
+        AS_FAST_AS_POSSIBLE
+    };
+
+    // With loop the recording restarts from the beginning when it ends, otherwise getLoad() returns {}.
+    ReplayPerformanceCounter(const std::string& path, Speed speed = AS_FAST_AS_POSSIBLE, bool loop = true);
+    ~ReplayPerformanceCounter();
+    std::vector<double> getLoad() override;
+    SampleInfo sample(double* load, std::size_t capacity) override;
+    bool finished() const;
+    std::size_t getNumberOfFrames() const;
+private:
+    class PerformanceCounterImpl;
+    PerformanceCounterImpl* performanceCounter = NULL;
+};
+}
+}
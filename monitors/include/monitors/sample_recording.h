@@ -0,0 +1,65 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace ov {
+namespace monitor {
+// Binary recording of counter samples: a header followed by fixed-size frames of a
+// monotonic timestamp (ns) and `width` 8-byte values, in host byte order.
+enum class SampleKind : std::uint32_t {
+    LOAD = 0,          // PerformanceCounter::getLoad() results (double)
+    IDLE_JIFFIES = 1   // raw per-core idle + iowait jiffies of /proc/stat (unsigned 64-bit)
+};
+
+class SampleRecorder {
+public:
+    // clockTicks is only meaningful for IDLE_JIFFIES
+    SampleRecorder(const std::string& path, SampleKind kind, std::size_t width, long clockTicks = 0);
+    ~SampleRecorder();
+    SampleRecorder(const SampleRecorder&) = delete;
+    SampleRecorder& operator=(const SampleRecorder&) = delete;
+
+    void write(std::chrono::nanoseconds timestamp, const double* values);
+    void write(std::chrono::nanoseconds timestamp, const unsigned long long* values);
+    void flush();
+
+private:
+    void writeFrame(std::chrono::nanoseconds timestamp, const void* values);
+
+    std::FILE* file;
+    SampleKind kind;
+    std::size_t width;
+};
+
+// Whole recording loaded into contiguous arrays.
+class SampleRecording {
+public:
+    explicit SampleRecording(const std::string& path);
+
+    SampleKind getKind() const;
+    std::size_t getWidth() const;
+    long getClockTicks() const;
+    std::size_t size() const;
+    std::chrono::nanoseconds getTimestamp(std::size_t frame) const;
+    // width values of the frame, only the array matching getKind() is filled
+    const double* getLoad(std::size_t frame) const;
+    const unsigned long long* getJiffies(std::size_t frame) const;
+
+private:
+    SampleKind kind;
+    std::size_t width;
+    long clockTicks;
+    std::vector<std::int64_t> timestamps;
+    std::vector<double> loads;
+    std::vector<unsigned long long> jiffies;
+};
+}
+}
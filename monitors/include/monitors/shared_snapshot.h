@@ -0,0 +1,70 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "load_history.h"
+
+namespace ov {
+namespace monitor {
+// One process samples and publishes device loads into a POSIX shared memory segment, the others map it
+// with SnapshotReader. Every device has its own slot guarded by a seqlock: the publisher never waits for
+// readers, and readers retry the copy if it raced with a write, so a read is a few memcpy()s with no
+// syscalls or locks. Slots keep the newest sample, the mean of the publisher's history window and a ring
+// of the last historySize samples.
+class SnapshotPublisher {
+public:
+    // Replaces the segment /name if it exists, readers of the previous one see it closed.
+    SnapshotPublisher(const std::string& name, std::size_t maxDevices = 8, std::size_t maxValues = 256,
+                      std::size_t historySize = 16);
+    ~SnapshotPublisher();
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+    // Publishes the newest sample of the history and its mean, values above maxValues are dropped.
+    // A device must not be published from several threads at a time.
+    void publish(std::size_t device, const std::string& deviceName, const LoadHistory& history);
+    std::size_t getMaxDevices() const;
+
+private:
+    std::string name;
+    std::uint8_t* segment = NULL;
+    std::size_t size = 0;
+};
+
+class SnapshotReader {
+public:
+    struct Snapshot {
+        char name[32] = {};
+        std::uint64_t updates = 0;           // samples published so far
+        std::chrono::nanoseconds timestamp;  // steady_clock time of the newest sample
+        std::vector<double> load;            // the newest sample
+        std::vector<double> mean;
+        std::vector<double> history;         // oldest sample first, load.size() values each
+    };
+
+    explicit SnapshotReader(const std::string& name);
+    ~SnapshotReader();
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    std::size_t getMaxDevices() const;
+    std::size_t getMaxValues() const;
+    std::size_t getHistorySize() const;
+    // The publisher has exited or was replaced, open a new reader to follow the new one.
+    bool isClosed() const;
+    // Copies a consistent snapshot of the device, the vectors are reused. Returns false if the device
+    // was never published, or the publisher kept writing it (e.g. it died in the middle of a write).
+    bool read(std::size_t device, Snapshot& snapshot, bool withHistory = false) const;
+
+private:
+    const std::uint8_t* segment = NULL;
+    std::size_t size = 0;
+};
+}
+}
@@ -0,0 +1,244 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "performance_counter.h"
+#ifdef __linux__
+#include <unistd.h>
+#include "cpu_load_calculator.h"
+#include "proc_stat_parser.h"
+#endif
+
+namespace ov {
+namespace monitor {
+namespace detail {
+template <typename Counter, typename = void>
+struct CounterWidth : std::integral_constant<std::size_t, 0> {};
+
+template <typename Counter>
+struct CounterWidth<Counter, typename std::enable_if<(Counter::width > 0)>::type> :
+    std::integral_constant<std::size_t, Counter::width> {};
+
+// Offset of the I-th counter in the output, valid when the counters before it have static widths.
+template <std::size_t I, typename... Counters>
+struct StaticOffset;
+
+template <typename Counter, typename... Counters>
+struct StaticOffset<0, Counter, Counters...> : std::integral_constant<std::size_t, 0> {};
+
+template <std::size_t I, typename Counter, typename... Counters>
+struct StaticOffset<I, Counter, Counters...> :
+    std::integral_constant<std::size_t, CounterWidth<Counter>::value + StaticOffset<I - 1, Counters...>::value> {};
+
+// Sum of the widths, 0 if one of them is only known at runtime.
+template <typename... Counters>
+struct StaticWidth : std::integral_constant<std::size_t, 0> {};
+
+template <typename Counter>
+struct StaticWidth<Counter> : CounterWidth<Counter> {};
+
+template <typename Counter, typename Next, typename... Counters>
+struct StaticWidth<Counter, Next, Counters...> : std::integral_constant<std::size_t,
+    CounterWidth<Counter>::value == 0 || StaticWidth<Next, Counters...>::value == 0
+        ? 0 : CounterWidth<Counter>::value + StaticWidth<Next, Counters...>::value> {};
+}
+
+// Samples a fixed set of counters composed at compile time, for tight loops that can't afford DeviceMonitor.
+// The counters are default-constructed members and are called by their sample() directly, without virtual
+// dispatch, so any class with SampleInfo sample(double*, std::size_t) fits, PerformanceCounter or not.
+// A counter with a static constexpr width has a fixed slice of the output; if all of them do, the output
+// is a std::array of staticWidth values. Otherwise slices are sized by the first samples and the output
+// only reallocates when a counter reports a different number of values.
+// There is no history and no locking: tick() and the getters belong to one thread.
+template <typename... Counters>
+class StaticMonitor {
+public:
+    static constexpr std::size_t countersNumber = sizeof...(Counters);
+    static constexpr std::size_t staticWidth = detail::StaticWidth<Counters...>::value;
+
+    template <std::size_t I>
+    using Counter = typename std::tuple_element<I, std::tuple<Counters...>>::type;
+
+    // Valid when staticWidth isn't 0.
+    template <std::size_t I>
+    static constexpr std::size_t offset() {
+        return detail::StaticOffset<I, Counters...>::value;
+    }
+
+    StaticMonitor() : widths{{detail::CounterWidth<Counters>::value...}} {
+        updateOffsets();
+        resize(values, offsets[countersNumber]);
+    }
+    StaticMonitor(const StaticMonitor&) = delete;
+    StaticMonitor& operator=(const StaticMonitor&) = delete;
+
+    // Samples every counter into its slice. Counters without new data keep their previous values.
+    // Returns the number of counters that reported new values.
+    std::size_t tick() {
+        return sampleFrom<0>();
+    }
+
+    const double* data() const {
+        return values.data();
+    }
+
+    std::size_t size() const {
+        return offsets[countersNumber];
+    }
+
+    template <std::size_t I>
+    Counter<I>& counter() {
+        return std::get<I>(counters);
+    }
+
+    // The slice of the I-th counter, getWidth<I>() values.
+    template <std::size_t I>
+    const double* getLoad() const {
+        return values.data() + offsets[I];
+    }
+
+    template <std::size_t I>
+    std::size_t getWidth() const {
+        return widths[I];
+    }
+
+    // The result of the latest sample of the I-th counter.
+    template <std::size_t I>
+    const SampleInfo& getSampleInfo() const {
+        return infos[I];
+    }
+
+private:
+    typedef typename std::conditional<staticWidth != 0,
+        std::array<double, staticWidth>, std::vector<double>>::type Values;
+
+    template <std::size_t I>
+    typename std::enable_if<I == countersNumber, std::size_t>::type sampleFrom() {
+        return 0;
+    }
+
+    template <std::size_t I>
+    typename std::enable_if<I < countersNumber, std::size_t>::type sampleFrom() {
+        typedef Counter<I> Sampled;
+        Sampled& sampled = std::get<I>(counters);
+        // the qualified call is resolved at compile time even if sample() is virtual
+        SampleInfo info = sampled.Sampled::sample(values.data() + offsets[I], widths[I]);
+        if (info.status == SampleInfo::BUFFER_TOO_SMALL) {
+            relayout(I, info.size);
+            info = sampled.Sampled::sample(values.data() + offsets[I], widths[I]);
+        } else if (info.status == SampleInfo::OK && info.size != widths[I]) {
+            relayout(I, info.size);
+        }
+        infos[I] = info;
+        return (info.status == SampleInfo::OK ? 1 : 0) + sampleFrom<I + 1>();
+    }
+
+    void relayout(std::size_t counter, std::size_t width) {
+        if (staticWidth != 0) {
+            throw std::logic_error("A counter reported a number of values different from its static width");
+        }
+        widths[counter] = width;
+        updateOffsets();
+        resize(values, offsets[countersNumber]);
+        // the following slices moved, they are filled again by the rest of this tick
+        for (std::size_t i = offsets[counter + 1]; i < offsets[countersNumber]; ++i)
+            values[i] = 0;
+    }
+
+    void updateOffsets() {
+        offsets[0] = 0;
+        for (std::size_t i = 0; i < countersNumber; ++i)
+            offsets[i + 1] = offsets[i] + widths[i];
+    }
+
+    static void resize(std::vector<double>& values, std::size_t size) {
+        values.resize(size);
+    }
+
+    static void resize(std::array<double, staticWidth>& values, std::size_t) {
+        values.fill(0);
+    }
+
+    std::tuple<Counters...> counters;
+    std::array<std::size_t, countersNumber> widths;
+    std::array<std::size_t, countersNumber + 1> offsets;
+    std::array<SampleInfo, countersNumber> infos;
+    Values values;
+};
+
+template <typename... Counters>
+constexpr std::size_t StaticMonitor<Counters...>::countersNumber;
+template <typename... Counters>
+constexpr std::size_t StaticMonitor<Counters...>::staticWidth;
+
+#ifdef __linux__
+// The load of the first NCores cores, computed as by CpuPerformanceCounter (including NO_DATA for samples
+// taken less than 300 ms apart) but with its state inline and a static width. The other cores are ignored,
+// the constructor throws std::invalid_argument if the system has fewer cores.
+template <std::size_t NCores>
+class StaticCpuPerformanceCounter {
+public:
+    static constexpr std::size_t width = NCores;
+
+    explicit StaticCpuPerformanceCounter(const std::string& procStatPath = "/proc/stat") :
+        procStat{NCores, procStatPath, true}, clockTicks{sysconf(_SC_CLK_TCK)} {
+        readIdleCpuStat(prevIdleCpuStat);
+        // offline cores may be missing from the file
+        std::size_t systemCores = std::max(static_cast<std::size_t>(sysconf(_SC_NPROCESSORS_CONF)),
+                                           procStat.getListedCores());
+        if (NCores > systemCores) {
+            throw std::invalid_argument("StaticCpuPerformanceCounter has more cores than the system");
+        }
+        prevTimePoint = std::chrono::steady_clock::now();
+    }
+
+    SampleInfo sample(double* load, std::size_t capacity) {
+        SampleInfo info;
+        if (capacity < NCores) {
+            info.status = SampleInfo::BUFFER_TOO_SMALL;
+            info.size = NCores;
+            return info;
+        }
+        std::array<unsigned long long, NCores> idleCpuStat;
+        readIdleCpuStat(idleCpuStat);
+        info.timestamp = std::chrono::steady_clock::now();
+        if (!CpuLoadCalculator::computeLoad(idleCpuStat.data(), prevIdleCpuStat.data(), NCores, clockTicks,
+                                            info.timestamp - prevTimePoint, load))
+            return info;
+        info.interval = info.timestamp - prevTimePoint;
+        prevIdleCpuStat = idleCpuStat;
+        prevTimePoint = info.timestamp;
+        info.status = SampleInfo::OK;
+        info.size = NCores;
+        return info;
+    }
+
+private:
+    void readIdleCpuStat(std::array<unsigned long long, NCores>& idleCpuStat) {
+        procStat.update();
+        for (std::size_t i = 0; i < NCores; ++i)
+            idleCpuStat[i] = procStat.getIdleJiffies(i);
+    }
+
+    ProcStatParser procStat;
+    long clockTicks;
+    std::array<unsigned long long, NCores> prevIdleCpuStat;
+    std::chrono::steady_clock::time_point prevTimePoint;
+};
+
+template <std::size_t NCores>
+constexpr std::size_t StaticCpuPerformanceCounter<NCores>::width;
+#endif
+}
+}
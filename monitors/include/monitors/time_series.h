@@ -0,0 +1,117 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include "performance_counter.h"
+
+namespace ov {
+namespace monitor {
+class BitWriter;
+
+// Append-only, Gorilla-style compressed storage of samples of `width` doubles. Samples are grouped into
+// self-contained blocks: timestamps are delta-of-delta encoded, every column is XOR encoded against its
+// previous value. Block headers carry the time range, so readers skip blocks without decoding them.
+// Timestamps are stored in units of `resolution` and must not decrease.
+class TimeSeriesWriter {
+public:
+    // Appends to the file if it exists and has the same width and resolution. A torn last block, left by a
+    // crash in the middle of a write, is truncated first.
+    TimeSeriesWriter(const std::string& path, std::size_t width,
+                     std::chrono::nanoseconds resolution = std::chrono::milliseconds{1},
+                     std::size_t samplesPerBlock = 1024);
+    ~TimeSeriesWriter();
+    TimeSeriesWriter(const TimeSeriesWriter&) = delete;
+    TimeSeriesWriter& operator=(const TimeSeriesWriter&) = delete;
+
+    void append(std::chrono::nanoseconds timestamp, const double* values);
+    // Writes the current (partial) block, the next sample starts a new one.
+    void flush();
+    std::size_t getWidth() const;
+    // Of the last sample appended or already in the file, nanoseconds::min() if there is none.
+    std::chrono::nanoseconds getLastTimestamp() const;
+
+private:
+    std::FILE* file;
+    std::size_t width;
+    std::int64_t resolution;
+    std::size_t samplesPerBlock;
+    std::unique_ptr<BitWriter> payload;
+    std::size_t count = 0;
+    std::int64_t firstTimestamp = 0;
+    std::int64_t prevTimestamp = std::numeric_limits<std::int64_t>::min();
+    std::int64_t prevDelta = 0;
+    std::vector<std::uint64_t> prevValues;
+    std::vector<unsigned> prevLeading;
+    std::vector<unsigned> prevTrailing;
+};
+
+// Memory-mapped reader of TimeSeriesWriter files.
+class TimeSeriesReader {
+public:
+    typedef std::function<void(std::chrono::nanoseconds timestamp, const double* values)> Visitor;
+
+    explicit TimeSeriesReader(const std::string& path);
+    ~TimeSeriesReader();
+    TimeSeriesReader(const TimeSeriesReader&) = delete;
+    TimeSeriesReader& operator=(const TimeSeriesReader&) = delete;
+
+    // Maps the file again to see the blocks written since the last call.
+    void refresh();
+    std::size_t getWidth() const;
+    std::size_t getNumberOfBlocks() const;
+    std::size_t getNumberOfSamples() const;
+    std::chrono::nanoseconds getFirstTimestamp() const;
+    std::chrono::nanoseconds getLastTimestamp() const;
+    // Visits the samples with from <= timestamp <= to in order, only decoding the blocks overlapping the range.
+    // Returns the number of visited samples.
+    std::size_t scan(std::chrono::nanoseconds from, std::chrono::nanoseconds to, const Visitor& visitor) const;
+
+private:
+    struct Block {
+        std::size_t offset;  // of the payload
+        std::size_t payloadBytes;
+        std::size_t count;
+        std::int64_t firstTimestamp;
+        std::int64_t lastTimestamp;
+    };
+
+    void map();
+    void unmap();
+    void decode(const Block& block, std::int64_t from, std::int64_t to, const Visitor& visitor,
+                std::size_t& visited) const;
+
+    std::string path;
+    const std::uint8_t* data = NULL;
+    std::size_t size = 0;
+    std::vector<std::uint8_t> buffer;  // the file contents where mmap() is not available
+    std::size_t width = 0;
+    std::int64_t resolution = 1;
+    std::vector<Block> blocks;
+    std::size_t samplesNumber = 0;
+};
+
+// Archives every non-empty sample of the wrapped counter with its wall clock time. Samples taken after the
+// clock stepped back are stamped with the last timestamp instead.
+class ArchivingPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    ArchivingPerformanceCounter(const std::shared_ptr<ov::monitor::PerformanceCounter>& performanceCounter,
+                                const std::string& path);
+    std::vector<double> getLoad() override;
+    void flush();
+private:
+    const std::shared_ptr<ov::monitor::PerformanceCounter> performanceCounter;
+    std::unique_ptr<TimeSeriesWriter> writer;
+    std::string path;
+};
+}
+}
@@ -0,0 +1,203 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/alert_engine.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace ov {
+namespace monitor {
+const std::size_t AlertEngine::npos;
+
+std::size_t AlertEngine::addThresholdRule(const std::string& name, Scope scope, std::size_t device, double threshold,
+                                          Direction direction, std::chrono::milliseconds hold) {
+    return addRule(Rule{name, THRESHOLD, scope, device, threshold, direction, hold, 0, 0});
+}
+
+std::size_t AlertEngine::addRateRule(const std::string& name, Scope scope, std::size_t device, double ratePerSecond,
+                                     Direction direction, std::chrono::milliseconds hold) {
+    return addRule(Rule{name, RATE, scope, device, ratePerSecond, direction, hold, 0, 0});
+}
+
+std::size_t AlertEngine::addAnomalyRule(const std::string& name, Scope scope, std::size_t device, double zScore,
+                                        double alpha, std::size_t warmup, std::chrono::milliseconds hold) {
+    if (alpha <= 0 || alpha > 1) {
+        throw std::invalid_argument("The EWMA weight must be in (0, 1]");
+    }
+    return addRule(Rule{name, ANOMALY, scope, device, zScore, ABOVE, hold, alpha, warmup});
+}
+
+std::size_t AlertEngine::addRule(const Rule& rule) {
+    std::lock_guard<std::mutex> lock{mutex};
+    rules.push_back(rule);
+    states.emplace_back(rule.scope == CORE ? 0 : 1);
+    return rules.size() - 1;
+}
+
+std::string AlertEngine::getRuleName(std::size_t rule) const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return rules.at(rule).name;
+}
+
+void AlertEngine::addCallback(const Callback& callback) {
+    std::lock_guard<std::mutex> lock{callbackMutex};
+    callbacks.push_back(callback);
+}
+
+std::size_t AlertEngine::getNumberOfFiringAlerts() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return firingNumber;
+}
+
+void AlertEngine::evaluate(std::size_t device, const double* load, std::size_t cores, const SampleInfo& info) {
+    auto timestamp = info.timestamp != std::chrono::steady_clock::time_point{}
+        ? info.timestamp : std::chrono::steady_clock::now();
+    double deviceMean = 0;
+    for (std::size_t core = 0; core < cores; ++core)
+        deviceMean += load[core];
+    deviceMean = cores > 0 ? deviceMean / cores : 0;
+
+    // evaluations are serialized so that callbacks see state changes in order
+    std::lock_guard<std::mutex> callbackLock{callbackMutex};
+    std::unique_lock<std::mutex> lock{mutex};
+    // keeps its capacity, so steady samples don't allocate
+    pendingAlerts.clear();
+    if (device >= deviceMeans.size()) {
+        deviceMeans.resize(device + 1, 0);
+        deviceSeen.resize(device + 1, false);
+        deviceFresh.resize(device + 1, false);
+    }
+    deviceMeans[device] = deviceMean;
+    deviceSeen[device] = true;
+    // a round ends when every device has a new sample, or when one of them brings a second sample first,
+    // so a device that stopped sampling doesn't hold the aggregate back
+    bool roundEnded = deviceFresh[device];
+    deviceFresh[device] = true;
+    double aggregate = 0;
+    std::size_t devicesNumber = 0;
+    bool allFresh = true;
+    for (std::size_t i = 0; i < deviceMeans.size(); ++i) {
+        if (deviceSeen[i]) {
+            aggregate += deviceMeans[i];
+            ++devicesNumber;
+            allFresh = allFresh && deviceFresh[i];
+        }
+    }
+    aggregate /= devicesNumber;
+    roundEnded = roundEnded || allFresh;
+    if (roundEnded)
+        deviceFresh.assign(deviceFresh.size(), false);
+
+    for (std::size_t rule = 0; rule < rules.size(); ++rule) {
+        std::vector<State>& ruleStates = states[rule];
+        switch (rules[rule].scope) {
+        case CORE:
+            if (rules[rule].device != device)
+                break;
+            // states are only reallocated when the number of cores changes
+            if (ruleStates.size() != cores) {
+                // the alerts of the old cores can't resolve by themselves anymore
+                for (std::size_t core = 0; core < ruleStates.size(); ++core)
+                    resolve(rule, ruleStates[core], device, core, timestamp);
+                ruleStates.assign(cores, State{});
+            }
+            for (std::size_t core = 0; core < cores; ++core)
+                update(rule, ruleStates[core], device, core, load[core], timestamp);
+            break;
+        case DEVICE:
+            if (rules[rule].device == device)
+                update(rule, ruleStates[0], device, npos, deviceMean, timestamp);
+            break;
+        case AGGREGATE:
+            if (roundEnded)
+                update(rule, ruleStates[0], device, npos, aggregate, timestamp);
+            break;
+        }
+    }
+    lock.unlock();
+    for (const Alert& alert : pendingAlerts) {
+        for (const Callback& callback : callbacks) {
+            // like MonitorHub callbacks, a throwing callback must not stop sampling
+            try {
+                callback(alert);
+            } catch (...) {}
+        }
+    }
+}
+
+void AlertEngine::update(std::size_t rule, State& state, std::size_t device, std::size_t core, double value,
+                         std::chrono::steady_clock::time_point timestamp) {
+    const Rule& config = rules[rule];
+    bool condition = false;
+    double score = value;
+    switch (config.kind) {
+    case THRESHOLD:
+        condition = config.direction == ABOVE ? value > config.threshold : value < config.threshold;
+        break;
+    case RATE: {
+        typedef std::chrono::duration<double, std::chrono::seconds::period> Sec;
+        double elapsed = std::chrono::duration_cast<Sec>(timestamp - state.prevTimestamp).count();
+        if (state.samples == 0 || elapsed <= 0) {
+            score = 0;
+            break;
+        }
+        score = (value - state.prevValue) / elapsed;
+        condition = config.direction == ABOVE ? score > config.threshold : score < -config.threshold;
+        break;
+    }
+    case ANOMALY: {
+        double diff = value - state.mean;
+        score = state.variance > 0 ? std::abs(diff) / std::sqrt(state.variance) : 0;
+        condition = state.samples >= config.warmup && score > config.threshold;
+        if (state.samples == 0) {
+            state.mean = value;
+        } else {
+            state.mean += config.alpha * diff;
+            state.variance = (1 - config.alpha) * (state.variance + config.alpha * diff * diff);
+        }
+        break;
+    }
+    }
+    ++state.samples;
+    state.prevValue = value;
+    state.prevTimestamp = timestamp;
+
+    bool changed = false;
+    if (condition) {
+        if (!state.active) {
+            state.active = true;
+            state.since = timestamp;
+        }
+        if (!state.firing && timestamp - state.since >= config.hold) {
+            state.firing = true;
+            ++firingNumber;
+            changed = true;
+        }
+    } else {
+        state.active = false;
+        if (state.firing) {
+            state.firing = false;
+            --firingNumber;
+            changed = true;
+        }
+    }
+    if (changed) {
+        Alert alert{state.firing ? Alert::FIRING : Alert::RESOLVED, rule, device, core, value, score, timestamp};
+        pendingAlerts.push_back(alert);
+    }
+}
+
+void AlertEngine::resolve(std::size_t rule, State& state, std::size_t device, std::size_t core,
+                          std::chrono::steady_clock::time_point timestamp) {
+    state.active = false;
+    if (!state.firing)
+        return;
+    state.firing = false;
+    --firingNumber;
+    Alert alert{Alert::RESOLVED, rule, device, core, state.prevValue, 0, timestamp};
+    pendingAlerts.push_back(alert);
+}
+}
+}
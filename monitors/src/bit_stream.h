@@ -0,0 +1,81 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ov {
+namespace monitor {
+// MSB-first bit packing used by the time series blocks.
+class BitWriter {
+public:
+    void write(std::uint64_t value, unsigned bits) {
+        while (bits > 0) {
+            if (used == 0)
+                bytes.push_back(0);
+            unsigned take = bits < 8 - used ? bits : 8 - used;
+            std::uint8_t chunk = static_cast<std::uint8_t>((value >> (bits - take)) & ((1u << take) - 1));
+            bytes.back() |= static_cast<std::uint8_t>(chunk << (8 - used - take));
+            used = (used + take) % 8;
+            bits -= take;
+        }
+    }
+
+    void writeBit(bool bit) {
+        write(bit ? 1 : 0, 1);
+    }
+
+    const std::vector<std::uint8_t>& data() const {
+        return bytes;
+    }
+
+    void clear() {
+        bytes.clear();
+        used = 0;
+    }
+
+private:
+    std::vector<std::uint8_t> bytes;
+    unsigned used = 0;  // bits used in the last byte
+};
+
+class BitReader {
+public:
+    BitReader(const std::uint8_t* data, std::size_t size) : data{data}, size{size} {}
+
+    std::uint64_t read(unsigned bits) {
+        std::uint64_t value = 0;
+        while (bits > 0) {
+            std::size_t byte = position >> 3;
+            if (byte >= size)
+                return bits < 64 ? value << bits : 0;  // corrupted block, pad with zeros
+            unsigned available = 8 - (position & 7);
+            unsigned take = bits < available ? bits : available;
+            std::uint64_t chunk = (data[byte] >> (available - take)) & ((1u << take) - 1);
+            value = (value << take) | chunk;
+            position += take;
+            bits -= take;
+        }
+        return value;
+    }
+
+    bool readBit() {
+        std::size_t byte = position >> 3;
+        if (byte >= size)
+            return false;
+        bool bit = (data[byte] >> (7 - (position & 7))) & 1;
+        ++position;
+        return bit;
+    }
+
+private:
+    const std::uint8_t* data;
+    std::size_t size;
+    std::size_t position = 0;
+};
+}
+}
@@ -0,0 +1,226 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/cgroup_performance_counter.h"
+
+#include <stdexcept>
+#ifdef __linux__
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+#include "proc_file.h"
+
+namespace {
+// usage_usec 1234
+// user_usec 1000
+// ...
+void parseCpuStat(const char* data, ov::monitor::CgroupPerformanceCounter::CgroupStat& stat) {
+    static const struct {
+        const char* key;
+        unsigned long long ov::monitor::CgroupPerformanceCounter::CgroupStat::*field;
+    } fields[] = {
+        {"usage_usec ", &ov::monitor::CgroupPerformanceCounter::CgroupStat::usageUsec},
+        {"user_usec ", &ov::monitor::CgroupPerformanceCounter::CgroupStat::userUsec},
+        {"system_usec ", &ov::monitor::CgroupPerformanceCounter::CgroupStat::systemUsec},
+        {"nr_periods ", &ov::monitor::CgroupPerformanceCounter::CgroupStat::nrPeriods},
+        {"nr_throttled ", &ov::monitor::CgroupPerformanceCounter::CgroupStat::nrThrottled},
+        {"throttled_usec ", &ov::monitor::CgroupPerformanceCounter::CgroupStat::throttledUsec},
+    };
+    for (const char* line = data; *line; line = ov::monitor::nextLine(line)) {
+        for (const auto& field : fields) {
+            std::size_t length = std::strlen(field.key);
+            if (std::strncmp(line, field.key, length) == 0) {
+                ov::monitor::parseUnsigned(line + length, stat.*field.field);
+                break;
+            }
+        }
+    }
+}
+
+// "max 100000" or "<quota> <period>", in us
+double parseCpuMax(const char* data) {
+    if (std::strncmp(data, "max", 3) == 0)
+        return 0;
+    char* end;
+    double quota = std::strtod(data, &end);
+    double period = std::strtod(end, NULL);
+    return period > 0 ? quota / period : 0;
+}
+
+// "a.slice", "/a.slice" and "a.slice/" name the same cgroup, "" and "/" the root one
+std::string cgroupPath(const std::string& root, const std::string& cgroup) {
+    std::size_t begin = cgroup.find_first_not_of('/');
+    if (begin == std::string::npos)
+        return root;
+    return root + "/" + cgroup.substr(begin, cgroup.find_last_not_of('/') + 1 - begin);
+}
+}
+
+namespace ov {
+namespace monitor {
+class CgroupPerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl(const std::vector<std::string>& cgroups, const std::string& cgroupfsRoot) :
+        groups(cgroups.size()) {
+        long nCpus = sysconf(_SC_NPROCESSORS_ONLN);
+        cpusNumber = nCpus > 0 ? nCpus : 1;
+        // the hybrid layout mounts cgroup v2 under unified/ next to the v1 controllers
+        std::string root = cgroupfsRoot;
+        if (access((root + "/cgroup.controllers").c_str(), F_OK) != 0
+            && access((root + "/unified/cgroup.controllers").c_str(), F_OK) == 0)
+            root += "/unified";
+        for (std::size_t i = 0; i < cgroups.size(); ++i) {
+            std::string path = cgroupPath(root, cgroups[i]);
+            groups[i].cpuStat.open(path + "/cpu.stat", 512);
+            // the root cgroup and cgroups without the cpu controller have no cpu.max
+            if (access((path + "/cpu.max").c_str(), F_OK) == 0)
+                groups[i].cpuMax.open(path + "/cpu.max", 64);
+        }
+    }
+
+    std::vector<double> getCgroupLoad() {
+        std::vector<double> load(groups.size());
+        if (sample(load.data(), load.size()).status == SampleInfo::OK)
+            return load;
+        return {};
+    }
+
+    SampleInfo sample(double* load, std::size_t capacity) {
+        SampleInfo info;
+        if (capacity < groups.size()) {
+            info.status = SampleInfo::BUFFER_TOO_SMALL;
+            info.size = groups.size();
+            return info;
+        }
+        auto timePoint = std::chrono::steady_clock::now();
+        for (Group& group : groups) {
+            group.prevStat = group.stat;
+            std::size_t size;
+            parseCpuStat(group.cpuStat.read(size), group.stat);
+            group.stat.quota = group.cpuMax.isOpen() ? parseCpuMax(group.cpuMax.read(size)) : 0;
+        }
+        typedef std::chrono::duration<double, std::micro> Us;
+        elapsed = std::chrono::duration_cast<Us>(timePoint - prevTimePoint).count();
+        bool firstSample = prevTimePoint == std::chrono::steady_clock::time_point{};
+        info.timestamp = timePoint;
+        if (!firstSample)
+            info.interval = timePoint - prevTimePoint;
+        prevTimePoint = timePoint;
+        if (firstSample || elapsed <= 0)
+            return info;
+        for (std::size_t i = 0; i < groups.size(); ++i) {
+            const Group& group = groups[i];
+            double allowed = group.stat.quota > 0 ? group.stat.quota : static_cast<double>(cpusNumber);
+            load[i] = delta(group.stat.usageUsec, group.prevStat.usageUsec) / elapsed / allowed;
+        }
+        info.status = SampleInfo::OK;
+        info.size = groups.size();
+        return info;
+    }
+
+    CgroupStat getStat(std::size_t cgroup) const {
+        return groups.at(cgroup).stat;
+    }
+
+    double getThrottledPeriodsRatio(std::size_t cgroup) const {
+        const Group& group = groups.at(cgroup);
+        double periods = delta(group.stat.nrPeriods, group.prevStat.nrPeriods);
+        return periods > 0 ? delta(group.stat.nrThrottled, group.prevStat.nrThrottled) / periods : 0;
+    }
+
+    double getThrottledTimeRatio(std::size_t cgroup) const {
+        const Group& group = groups.at(cgroup);
+        return elapsed > 0 ? delta(group.stat.throttledUsec, group.prevStat.throttledUsec) / elapsed : 0;
+    }
+
+private:
+    struct Group {
+        ProcFile cpuStat;
+        ProcFile cpuMax;
+        CgroupStat stat;
+        CgroupStat prevStat;
+    };
+
+    static double delta(unsigned long long value, unsigned long long prevValue) {
+        // counters restart when a cgroup is recreated with the same path
+        return value >= prevValue ? static_cast<double>(value - prevValue) : 0;
+    }
+
+    std::vector<Group> groups;
+    std::size_t cpusNumber;
+    double elapsed = 0;
+    std::chrono::steady_clock::time_point prevTimePoint;
+};
+
+std::string CgroupPerformanceCounter::getProcessCgroup(const std::string& procfsRoot, const std::string& pid) {
+    // cgroup v2 is the "0::" hierarchy, v1 controllers are listed with their own ids
+    std::string path = procfsRoot + "/" + pid + "/cgroup";
+    std::ifstream file{path};
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.compare(0, 3, "0::") == 0)
+            return line.substr(3) == "/" ? "" : line.substr(3);
+    }
+    throw std::runtime_error("No cgroup v2 hierarchy in " + path);
+}
+}
+}
+#else
+// not implemented
+namespace ov {
+namespace monitor {
+class CgroupPerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl(const std::vector<std::string>&, const std::string&) {}
+    std::vector<double> getCgroupLoad() {return {};}
+    SampleInfo sample(double*, std::size_t) {return {};}
+    CgroupStat getStat(std::size_t) const {return {};}
+    double getThrottledPeriodsRatio(std::size_t) const {return 0;}
+    double getThrottledTimeRatio(std::size_t) const {return 0;}
+};
+
+std::string CgroupPerformanceCounter::getProcessCgroup(const std::string&, const std::string&) {
+    return {};
+}
+}
+}
+#endif
+
+namespace ov {
+namespace monitor {
+CgroupPerformanceCounter::CgroupPerformanceCounter(const std::vector<std::string>& cgroups,
+                                                   const std::string& cgroupfsRoot, const std::string& procfsRoot) :
+    ov::monitor::PerformanceCounter("Cgroup"),
+    cgroups{cgroups.empty() ? std::vector<std::string>{getProcessCgroup(procfsRoot)} : cgroups},
+    cgroupfsRoot{cgroupfsRoot} {}
+CgroupPerformanceCounter::~CgroupPerformanceCounter() {
+    delete performanceCounter;
+}
+CgroupPerformanceCounter::PerformanceCounterImpl& CgroupPerformanceCounter::impl() {
+    if (!performanceCounter)
+        performanceCounter = new PerformanceCounterImpl(cgroups, cgroupfsRoot);
+    return *performanceCounter;
+}
+std::vector<double> CgroupPerformanceCounter::getLoad() {
+    return impl().getCgroupLoad();
+}
+SampleInfo CgroupPerformanceCounter::sample(double* load, std::size_t capacity) {
+    return impl().sample(load, capacity);
+}
+const std::vector<std::string>& CgroupPerformanceCounter::getCgroups() const {
+    return cgroups;
+}
+CgroupPerformanceCounter::CgroupStat CgroupPerformanceCounter::getStat(std::size_t cgroup) {
+    return impl().getStat(cgroup);
+}
+double CgroupPerformanceCounter::getThrottledPeriodsRatio(std::size_t cgroup) {
+    return impl().getThrottledPeriodsRatio(cgroup);
+}
+double CgroupPerformanceCounter::getThrottledTimeRatio(std::size_t cgroup) {
+    return impl().getThrottledTimeRatio(cgroup);
+}
+}
+}
@@ -0,0 +1,631 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/cluster.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#ifndef _WIN32
+#include <cerrno>
+#include <system_error>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+const std::uint32_t frameMagic = 0x464d564f;  // "OVMF"
+const std::uint8_t frameVersion = 1;
+// magic, version, host length, sequence, samples number
+const std::size_t frameHeaderSize = 4 + 1 + 1 + 4 + 2;
+// device length, width, timestamp
+const std::size_t sampleHeaderSize = 1 + 2 + 8;
+const std::size_t maxDatagramSize = 65507;
+// late or duplicate frames are only this far behind, farther back means the agent restarted
+const std::uint32_t reorderWindow = 1024;
+
+void putU16(char* out, std::uint16_t value) {
+    out[0] = static_cast<char>(value);
+    out[1] = static_cast<char>(value >> 8);
+}
+
+void putU32(char* out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i)
+        out[i] = static_cast<char>(value >> (8 * i));
+}
+
+void putU64(char* out, std::uint64_t value) {
+    for (int i = 0; i < 8; ++i)
+        out[i] = static_cast<char>(value >> (8 * i));
+}
+
+std::uint16_t getU16(const char* in) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(in);
+    return static_cast<std::uint16_t>(bytes[0] | bytes[1] << 8);
+}
+
+std::uint32_t getU32(const char* in) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(in);
+    std::uint32_t value = 0;
+    for (int i = 3; i >= 0; --i)
+        value = value << 8 | bytes[i];
+    return value;
+}
+
+std::uint64_t getU64(const char* in) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(in);
+    std::uint64_t value = 0;
+    for (int i = 7; i >= 0; --i)
+        value = value << 8 | bytes[i];
+    return value;
+}
+
+void putFloat(char* out, double value) {
+    float single = static_cast<float>(value);
+    std::uint32_t bits;
+    memcpy(&bits, &single, sizeof(bits));
+    putU32(out, bits);
+}
+
+double getFloat(const char* in) {
+    std::uint32_t bits = getU32(in);
+    float single;
+    memcpy(&single, &bits, sizeof(single));
+    return single;
+}
+
+#ifndef _WIN32
+struct Address {
+    sockaddr_storage storage;
+    socklen_t length;
+    std::string path;  // of a Unix socket
+};
+
+Address parseEndpoint(const std::string& endpoint) {
+    Address address = {};
+    const std::string udp = "udp://";
+    const std::string unixScheme = "unix://";
+    if (endpoint.compare(0, unixScheme.size(), unixScheme) == 0) {
+        address.path = endpoint.substr(unixScheme.size());
+        sockaddr_un* socketAddress = reinterpret_cast<sockaddr_un*>(&address.storage);
+        if (address.path.empty() || address.path.size() >= sizeof(socketAddress->sun_path)) {
+            throw std::invalid_argument("Invalid Unix socket path in " + endpoint);
+        }
+        socketAddress->sun_family = AF_UNIX;
+        memcpy(socketAddress->sun_path, address.path.c_str(), address.path.size() + 1);
+        address.length = sizeof(sockaddr_un);
+        return address;
+    }
+    std::size_t colon = endpoint.rfind(':');
+    if (endpoint.compare(0, udp.size(), udp) != 0 || colon < udp.size() || colon + 1 >= endpoint.size()) {
+        throw std::invalid_argument("Invalid endpoint " + endpoint + ", expected udp://<IPv4>:<port> or unix://<path>");
+    }
+    std::string host = endpoint.substr(udp.size(), colon - udp.size());
+    char* end;
+    unsigned long port = strtoul(endpoint.c_str() + colon + 1, &end, 10);
+    sockaddr_in* socketAddress = reinterpret_cast<sockaddr_in*>(&address.storage);
+    if (*end != 0 || port > std::numeric_limits<std::uint16_t>::max()
+        || inet_pton(AF_INET, host.c_str(), &socketAddress->sin_addr) != 1) {
+        throw std::invalid_argument("Invalid endpoint " + endpoint + ", expected udp://<IPv4>:<port> or unix://<path>");
+    }
+    socketAddress->sin_family = AF_INET;
+    socketAddress->sin_port = htons(static_cast<std::uint16_t>(port));
+    address.length = sizeof(sockaddr_in);
+    return address;
+}
+#endif
+}
+
+namespace ov {
+namespace monitor {
+ClusterAgent::ClusterAgent(const std::string& endpoint, const std::string& hostName, std::size_t maxFrameSize) :
+    hostName{hostName}, maxFrameSize{std::min(maxFrameSize, maxDatagramSize)} {
+#ifdef _WIN32
+    throw std::runtime_error("ClusterAgent is not implemented on Windows");
+#else
+    if (this->hostName.empty()) {
+        char name[256] = {};
+        if (gethostname(name, sizeof(name) - 1) != 0) {
+            throw std::system_error(errno, std::system_category(), "gethostname() failed");
+        }
+        this->hostName = name;
+    }
+    if (this->hostName.size() > std::numeric_limits<std::uint8_t>::max()) {
+        throw std::invalid_argument("Host name " + this->hostName + " is longer than 255 characters");
+    }
+    Address address = parseEndpoint(endpoint);
+    fd = socket(address.storage.ss_family, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::system_error(errno, std::system_category(), "socket() failed");
+    }
+    // a Unix socket can only be connected once the collector is bound, so it is addressed on every send
+    if (address.path.empty() && connect(fd, reinterpret_cast<sockaddr*>(&address.storage), address.length) != 0) {
+        int error = errno;
+        close(fd);
+        throw std::system_error(error, std::system_category(), "Can't connect to " + endpoint);
+    }
+    if (!address.path.empty())
+        unixPath = address.path;
+    frame.reserve(this->maxFrameSize);
+#endif
+}
+
+ClusterAgent::~ClusterAgent() {
+    stop();
+#ifndef _WIN32
+    if (fd >= 0) {
+        std::lock_guard<std::mutex> lock{mutex};
+        flushLocked();
+        close(fd);
+    }
+#endif
+}
+
+void ClusterAgent::addMonitor(const std::shared_ptr<DeviceMonitor>& monitor, const std::string& device) {
+    if (device.size() > std::numeric_limits<std::uint8_t>::max()) {
+        throw std::invalid_argument("Device name " + device + " is longer than 255 characters");
+    }
+    std::lock_guard<std::mutex> lock{mutex};
+    if (thread.joinable()) {
+        throw std::logic_error("Monitors can't be added to a running ClusterAgent");
+    }
+    sources.push_back({monitor, device, std::chrono::steady_clock::time_point{}});
+}
+
+void ClusterAgent::append(const std::string& device, const double* load, std::size_t size,
+                          std::chrono::system_clock::time_point timestamp) {
+    std::lock_guard<std::mutex> lock{mutex};
+    appendLocked(device, load, size, timestamp);
+}
+
+void ClusterAgent::appendLocked(const std::string& device, const double* load, std::size_t size,
+                                std::chrono::system_clock::time_point timestamp) {
+    if (device.size() > std::numeric_limits<std::uint8_t>::max()) {
+        throw std::invalid_argument("Device name " + device + " is longer than 255 characters");
+    }
+    std::size_t sampleSize = sampleHeaderSize + device.size() + 4 * size;
+    if (frameHeaderSize + hostName.size() + sampleSize > maxDatagramSize) {
+        throw std::invalid_argument("A sample of " + device + " doesn't fit into a datagram");
+    }
+    if (frameSamples > 0 && (frame.size() + sampleSize > maxFrameSize
+                             || frameSamples == std::numeric_limits<std::uint16_t>::max())) {
+        flushLocked();
+    }
+    if (frameSamples == 0) {
+        frame.resize(frameHeaderSize + hostName.size());
+        char* header = &frame[0];
+        putU32(header, frameMagic);
+        header[4] = static_cast<char>(frameVersion);
+        header[5] = static_cast<char>(hostName.size());
+        memcpy(header + 6, hostName.data(), hostName.size());
+        putU32(header + 6 + hostName.size(), sequence);
+    }
+    std::size_t offset = frame.size();
+    frame.resize(offset + sampleSize);
+    char* sample = &frame[offset];
+    sample[0] = static_cast<char>(device.size());
+    memcpy(sample + 1, device.data(), device.size());
+    sample += 1 + device.size();
+    putU16(sample, static_cast<std::uint16_t>(size));
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(timestamp.time_since_epoch()).count();
+    putU64(sample + 2, static_cast<std::uint64_t>(us));
+    sample += 10;
+    for (std::size_t i = 0; i < size; ++i)
+        putFloat(sample + 4 * i, load[i]);
+    ++frameSamples;
+}
+
+void ClusterAgent::flush() {
+    std::lock_guard<std::mutex> lock{mutex};
+    flushLocked();
+}
+
+void ClusterAgent::flushLocked() {
+    if (frameSamples == 0)
+        return;
+    putU16(&frame[frameHeaderSize - 2 + hostName.size()], static_cast<std::uint16_t>(frameSamples));
+    ++sequence;
+    frameSamples = 0;
+#ifndef _WIN32
+    ssize_t sent;
+    if (unixPath.empty()) {
+        do {
+            sent = send(fd, frame.data(), frame.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+        } while (sent < 0 && errno == EINTR);
+    } else {
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        memcpy(address.sun_path, unixPath.c_str(), unixPath.size() + 1);
+        do {
+            sent = sendto(fd, frame.data(), frame.size(), MSG_DONTWAIT | MSG_NOSIGNAL,
+                          reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        } while (sent < 0 && errno == EINTR);
+    }
+    // samples are best effort: the agent must not block or throw because the collector is down or slow
+    if (sent == static_cast<ssize_t>(frame.size()))
+        ++sentFrames;
+    else
+        ++droppedFrames;
+#endif
+}
+
+void ClusterAgent::start(std::chrono::milliseconds period) {
+    if (period < std::chrono::milliseconds{1}) {
+        throw std::invalid_argument("The period of the agent must be at least 1 ms");
+    }
+    stop();
+    std::lock_guard<std::mutex> lock{mutex};
+    this->period = period;
+    stopRequested = false;
+    thread = std::thread(&ClusterAgent::loop, this);
+}
+
+void ClusterAgent::stop() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (!thread.joinable())
+            return;
+        stopRequested = true;
+    }
+    wakeUp.notify_all();
+    thread.join();
+}
+
+bool ClusterAgent::isRunning() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return thread.joinable();
+}
+
+void ClusterAgent::loop() {
+    std::unique_lock<std::mutex> lock{mutex};
+    auto deadline = std::chrono::steady_clock::now();
+    while (!stopRequested) {
+        for (Source& source : sources) {
+            // the history is read under the monitor lock, the frame is built under the agent lock
+            SampleInfo info;
+            {
+                // one lock, so the sample info belongs to the sample that is copied
+                DeviceMonitor::HistoryView history = source.monitor->getHistoryView();
+                info = history.getLastSampleInfo();
+                if (info.status != SampleInfo::OK || info.timestamp == source.lastTimestamp || history->size() == 0)
+                    continue;
+                scratch.resize(history->getNumberOfCores());
+                for (std::size_t core = 0; core < scratch.size(); ++core)
+                    scratch[core] = history->at(history->size() - 1, core);
+            }
+            source.lastTimestamp = info.timestamp;
+            auto age = std::chrono::steady_clock::now() - info.timestamp;
+            auto timestamp = std::chrono::system_clock::now()
+                - std::chrono::duration_cast<std::chrono::system_clock::duration>(age);
+            try {
+                appendLocked(source.device, scratch.data(), scratch.size(), timestamp);
+            } catch (const std::invalid_argument&) {
+                // a sample too wide for a datagram is skipped, the other devices are still shipped
+            }
+        }
+        flushLocked();
+        deadline += period;
+        wakeUp.wait_until(lock, deadline, [this] { return stopRequested; });
+    }
+}
+
+const std::string& ClusterAgent::getHostName() const {
+    return hostName;
+}
+
+std::uint64_t ClusterAgent::getSentFrames() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return sentFrames;
+}
+
+std::uint64_t ClusterAgent::getDroppedFrames() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return droppedFrames;
+}
+
+ClusterCollector::ClusterCollector(const std::string& endpoint) : endpoint{endpoint} {}
+
+ClusterCollector::~ClusterCollector() {
+    stop();
+}
+
+bool ClusterCollector::isRunning() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return running;
+}
+
+std::string ClusterCollector::getEndpoint() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return endpoint;
+}
+
+bool ClusterCollector::ingest(const char* data, std::size_t size) {
+    // validate the whole frame first, so a malformed one doesn't leave a host half updated
+    bool valid = size >= frameHeaderSize && getU32(data) == frameMagic
+        && static_cast<std::uint8_t>(data[4]) == frameVersion;
+    std::size_t hostSize = valid ? static_cast<std::uint8_t>(data[5]) : 0;
+    valid = valid && size >= frameHeaderSize + hostSize;
+    std::size_t samplesNumber = valid ? getU16(data + frameHeaderSize - 2 + hostSize) : 0;
+    std::size_t offset = frameHeaderSize + hostSize;
+    for (std::size_t i = 0; valid && i < samplesNumber; ++i) {
+        if (offset + 1 > size) {
+            valid = false;
+            break;
+        }
+        std::size_t deviceSize = static_cast<std::uint8_t>(data[offset]);
+        if (offset + sampleHeaderSize + deviceSize > size) {
+            valid = false;
+            break;
+        }
+        std::size_t width = getU16(data + offset + 1 + deviceSize);
+        offset += sampleHeaderSize + deviceSize + 4 * width;
+        valid = offset <= size;
+    }
+    valid = valid && offset == size;
+
+    std::lock_guard<std::mutex> lock{mutex};
+    if (!valid) {
+        ++stats.malformedFrames;
+        return false;
+    }
+    // the scratch key keeps its capacity, so known hosts are looked up without allocating
+    hostKey.assign(data + 6, hostSize);
+    auto found = hosts.find(hostKey);
+    bool newHost = found == hosts.end();
+    if (newHost)
+        found = hosts.emplace(hostKey, Host{}).first;
+    Host& host = found->second;
+    std::uint32_t sequence = getU32(data + 6 + hostSize);
+    std::uint32_t behind = host.sequence - sequence;
+    if (!newHost && sequence != 0 && behind > 0 && behind <= reorderWindow) {
+        // a late or duplicate frame would overwrite newer samples and rewind the sequence
+        ++stats.reorderedFrames;
+        return true;
+    }
+    // an agent restart resets its sequence to 0, don't count that as billions of lost frames
+    std::uint32_t gap = sequence - host.sequence;
+    if (!newHost && sequence != 0 && gap < (1u << 16)) {
+        host.lostFrames += gap;
+        stats.lostFrames += gap;
+    }
+    host.sequence = sequence + 1;
+    ++host.frames;
+    host.lastSeen = std::chrono::steady_clock::now();
+    ++stats.frames;
+    stats.samples += samplesNumber;
+
+    offset = frameHeaderSize + hostSize;
+    for (std::size_t i = 0; i < samplesNumber; ++i) {
+        std::size_t deviceSize = static_cast<std::uint8_t>(data[offset]);
+        const char* deviceName = data + offset + 1;
+        const char* sample = deviceName + deviceSize;
+        std::size_t width = getU16(sample);
+        auto us = static_cast<std::int64_t>(getU64(sample + 2));
+        const char* values = sample + 10;
+        offset += sampleHeaderSize + deviceSize + 4 * width;
+
+        DeviceLoad* device = nullptr;
+        for (DeviceLoad& known : host.devices) {
+            if (known.device.size() == deviceSize && memcmp(known.device.data(), deviceName, deviceSize) == 0) {
+                device = &known;
+                break;
+            }
+        }
+        if (!device) {
+            host.devices.push_back(DeviceLoad{});
+            device = &host.devices.back();
+            device->device.assign(deviceName, deviceSize);
+        }
+        device->load.resize(width);
+        double sum = 0;
+        for (std::size_t core = 0; core < width; ++core) {
+            device->load[core] = getFloat(values + 4 * core);
+            sum += device->load[core];
+        }
+        device->mean = width > 0 ? sum / width : 0;
+        ++device->samples;
+        device->timestamp = std::chrono::system_clock::time_point{
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds{us})};
+    }
+    return true;
+}
+
+std::vector<std::string> ClusterCollector::getHosts() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    std::vector<std::string> names;
+    names.reserve(hosts.size());
+    for (const auto& host : hosts)
+        names.push_back(host.first);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool ClusterCollector::getHostLoad(const std::string& host, HostLoad& load) const {
+    std::lock_guard<std::mutex> lock{mutex};
+    auto found = hosts.find(host);
+    if (found == hosts.end())
+        return false;
+    load.host = host;
+    load.devices = found->second.devices;
+    load.frames = found->second.frames;
+    load.lostFrames = found->second.lostFrames;
+    load.lastSeen = found->second.lastSeen;
+    return true;
+}
+
+std::vector<ClusterCollector::FleetLoad> ClusterCollector::getFleetLoad() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    std::vector<FleetLoad> fleet;
+    for (const auto& host : hosts) {
+        for (const DeviceLoad& device : host.second.devices) {
+            auto found = std::find_if(fleet.begin(), fleet.end(),
+                                      [&device](const FleetLoad& load) { return load.device == device.device; });
+            if (found == fleet.end()) {
+                FleetLoad load;
+                load.device = device.device;
+                load.min = load.max = device.mean;
+                fleet.push_back(load);
+                found = fleet.end() - 1;
+            }
+            ++found->hosts;
+            found->mean += device.mean;
+            found->min = std::min(found->min, device.mean);
+            found->max = std::max(found->max, device.mean);
+            found->samples += device.samples;
+        }
+    }
+    for (FleetLoad& load : fleet)
+        load.mean /= load.hosts;
+    std::sort(fleet.begin(), fleet.end(), [](const FleetLoad& a, const FleetLoad& b) { return a.device < b.device; });
+    return fleet;
+}
+
+ClusterCollector::Stats ClusterCollector::getStats() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return stats;
+}
+
+void ClusterCollector::expireHosts(std::chrono::milliseconds timeout) {
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock{mutex};
+    for (auto host = hosts.begin(); host != hosts.end();) {
+        if (now - host->second.lastSeen > timeout)
+            host = hosts.erase(host);
+        else
+            ++host;
+    }
+}
+
+#ifdef _WIN32
+// not implemented
+void ClusterCollector::start() {
+    throw std::runtime_error("ClusterCollector is not implemented on Windows");
+}
+
+void ClusterCollector::stop() {}
+
+void ClusterCollector::receive() {}
+#else
+void ClusterCollector::start() {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (running)
+        return;
+    Address address = parseEndpoint(endpoint);
+    if (!address.path.empty()) {
+        // a collector that wasn't stopped leaves its socket behind, but nothing else is replaced
+        struct stat status;
+        if (lstat(address.path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode))
+            unlink(address.path.c_str());
+    }
+    fd = socket(address.storage.ss_family, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::system_error(errno, std::system_category(), "socket() failed");
+    }
+    // room for bursts of many agents flushing at the same tick
+    int bufferSize = 8 << 20;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+    socklen_t length = address.length;
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address.storage), address.length) != 0
+        || getsockname(fd, reinterpret_cast<sockaddr*>(&address.storage), &length) != 0
+        || pipe2(wakeUpFds, O_CLOEXEC) != 0) {
+        int error = errno;
+        close(fd);
+        fd = -1;
+        throw std::system_error(error, std::system_category(), "Can't bind " + endpoint);
+    }
+    if (address.path.empty()) {
+        char host[INET_ADDRSTRLEN];
+        const sockaddr_in* socketAddress = reinterpret_cast<const sockaddr_in*>(&address.storage);
+        inet_ntop(AF_INET, &socketAddress->sin_addr, host, sizeof(host));
+        endpoint = "udp://" + std::string{host} + ':' + std::to_string(ntohs(socketAddress->sin_port));
+    }
+    running = true;
+    thread = std::thread(&ClusterCollector::receive, this);
+}
+
+void ClusterCollector::stop() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (!running)
+            return;
+    }
+    char wakeUp = 0;
+    while (write(wakeUpFds[1], &wakeUp, 1) < 0 && errno == EINTR) {}
+    thread.join();
+    std::lock_guard<std::mutex> lock{mutex};
+    close(fd);
+    close(wakeUpFds[0]);
+    close(wakeUpFds[1]);
+    fd = wakeUpFds[0] = wakeUpFds[1] = -1;
+    const std::string unixScheme = "unix://";
+    if (endpoint.compare(0, unixScheme.size(), unixScheme) == 0)
+        unlink(endpoint.c_str() + unixScheme.size());
+    running = false;
+}
+
+void ClusterCollector::receive() {
+    // datagrams are drained in batches, one recvmmsg() per poll() where it's available
+    const std::size_t batchSize = 64;
+    // as big as the frames agents may send, sizing buffers by a typical frame would truncate the others
+    const std::size_t bufferSize = maxDatagramSize;
+    std::vector<char> buffers(batchSize * bufferSize);
+    pollfd fds[2] = {{fd, POLLIN, 0}, {wakeUpFds[0], POLLIN, 0}};
+#ifdef __linux__
+    std::vector<iovec> iovecs(batchSize);
+    std::vector<mmsghdr> messages(batchSize);
+    for (std::size_t i = 0; i < batchSize; ++i) {
+        iovecs[i] = {&buffers[i * bufferSize], bufferSize};
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+#endif
+    while (true) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+        if (fds[1].revents)
+            return;
+        if (!(fds[0].revents & POLLIN))
+            continue;
+        while (true) {
+#ifdef __linux__
+            int received = recvmmsg(fd, messages.data(), batchSize, MSG_DONTWAIT, nullptr);
+            if (received <= 0)
+                break;
+            for (int i = 0; i < received; ++i) {
+                if (messages[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    ++stats.malformedFrames;
+                } else {
+                    ingest(&buffers[i * bufferSize], messages[i].msg_len);
+                }
+            }
+            if (static_cast<std::size_t>(received) < batchSize)
+                break;
+#else
+            ssize_t received = recv(fd, buffers.data(), bufferSize, MSG_DONTWAIT | MSG_TRUNC);
+            if (received < 0)
+                break;
+            if (static_cast<std::size_t>(received) > bufferSize) {
+                std::lock_guard<std::mutex> lock{mutex};
+                ++stats.malformedFrames;
+            } else {
+                ingest(buffers.data(), static_cast<std::size_t>(received));
+            }
+#endif
+        }
+    }
+}
+#endif
+}
+}
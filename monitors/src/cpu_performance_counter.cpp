@@ -6,6 +6,7 @@
 #include <iostream>
 #include "monitors/performance_counter.h"
 #include "monitors/cpu_performance_counter.h"
+#include "monitors/instrumentation.h"
 #ifdef _WIN32
 #define NOMINMAX
 #include "query_wrapper.h"
@@ -65,10 +66,14 @@ public:
             }
         }
         lastTimeStamp = std::chrono::system_clock::now();
-        status = PdhCollectQueryData(query);
+        {
+            PhaseTimer timer{instrumentation, CounterInstrumentation::READ};
+            status = PdhCollectQueryData(query);
+        }
         if (ERROR_SUCCESS != status) {
             throw std::system_error(status, std::system_category(), "PdhCollectQueryData() failed");
         }
+        PhaseTimer timer{instrumentation, CounterInstrumentation::COMPUTE};
         PDH_FMT_COUNTERVALUE displayValue;
         std::vector<double> cpuLoad(coreTimeCounters.size());
         for (std::size_t i = 0; i < coreTimeCounters.size(); ++i) {
@@ -90,84 +95,127 @@ public:
         return cpuLoad;
     }
 
+    SampleInfo sample(double* load, std::size_t capacity) {
+        SampleInfo info;
+        if (capacity < coreTimeCounters.size()) {
+            // checked before collecting, so the sample isn't lost
+            info.status = SampleInfo::BUFFER_TOO_SMALL;
+            info.size = coreTimeCounters.size();
+            return info;
+        }
+        std::vector<double> cpuLoad = getCpuLoad();
+        info.timestamp = std::chrono::steady_clock::now();
+        if (prevTimestamp != std::chrono::steady_clock::time_point{})
+            info.interval = info.timestamp - prevTimestamp;
+        prevTimestamp = info.timestamp;
+        info.size = cpuLoad.size();
+        if (cpuLoad.empty()) {
+            info.status = SampleInfo::NO_DATA;
+        } else {
+            std::copy(cpuLoad.begin(), cpuLoad.end(), load);
+            info.status = SampleInfo::OK;
+        }
+        return info;
+    }
 
     int getNumberOfCores() {
         return 0; 
     }
 
+    void startRecording(const std::string&) {
+        throw std::runtime_error("Recording of raw CPU counters is not implemented");
+    }
+
+    void stopRecording() {}
+
 private:
     QueryWrapper query;
     std::vector<PDH_HCOUNTER> coreTimeCounters;
     std::chrono::time_point<std::chrono::system_clock> lastTimeStamp = std::chrono::system_clock::now();
+    std::chrono::steady_clock::time_point prevTimestamp;
+    CounterInstrumentation& instrumentation = Instrumentation::get("CPU");
 };
 
 #elif __linux__
 #include <chrono>
-#include <regex>
 #include <utility>
-#include <fstream>
 #include <unistd.h>
+#include "monitors/proc_stat_parser.h"
+#include "monitors/sample_recording.h"
+#include "monitors/cpu_load_calculator.h"
 
 namespace {
 const long clockTicks = sysconf(_SC_CLK_TCK);
 
 const std::size_t nCores = sysconf(_SC_NPROCESSORS_CONF);
-
-std::vector<unsigned long> getIdleCpuStat() {
-    std::vector<unsigned long> idleCpuStat(nCores);
-    std::ifstream procStat("/proc/stat");
-    std::string line;
-    std::smatch match;
-    std::regex coreJiffies("^cpu(\\d+)\\s+"
-        "(\\d+)\\s+"
-        "(\\d+)\\s+"
-        "(\\d+)\\s+"
-        "(\\d+)\\s+" // idle
-        "(\\d+)"); // iowait
-
-    while (std::getline(procStat, line)) {
-        if (std::regex_search(line, match, coreJiffies)) {
-            // it doesn't handle overflow of sum and overflows of /proc/stat values
-            unsigned long idleInfo = stoul(match[5]) + stoul(match[6]),
-                coreId = stoul(match[1]);
-            if (nCores <= coreId) {
-                throw std::runtime_error("The number of cores has changed");
-            }
-            idleCpuStat[coreId] = idleInfo;
-        }
-    }
-    return idleCpuStat;
-}
 }
 
 namespace ov {
 namespace monitor {
 class CpuPerformanceCounter::PerformanceCounterImpl {
 public:
-    PerformanceCounterImpl() : prevIdleCpuStat{getIdleCpuStat()}, prevTimePoint{std::chrono::steady_clock::now()} {}
+    PerformanceCounterImpl() : procStat{::nCores}, idleCpuStat(::nCores), cpuLoadCalculator{::nCores, clockTicks},
+        instrumentation(Instrumentation::get("CPU")) {
+        procStat.setInstrumentation(&instrumentation);
+        readIdleCpuStat();
+        cpuLoadCalculator.reset(idleCpuStat.data(), timePoint);
+    }
 
     std::vector<double> getCpuLoad() {
-        std::vector<unsigned long> idleCpuStat = getIdleCpuStat();
-        auto timePoint = std::chrono::steady_clock::now();
-        // don't update data too frequently which may result in negative values for cpuLoad.
-        // It may happen when collectData() is called just after setHistorySize().
-        if (timePoint - prevTimePoint > std::chrono::milliseconds{300}) {
-            std::vector<double> cpuLoad(::nCores);
-            for (std::size_t i = 0; i < idleCpuStat.size(); ++i) {
-                double idleDiff = idleCpuStat[i] - prevIdleCpuStat[i];
-                typedef std::chrono::duration<double, std::chrono::seconds::period> Sec;
-                cpuLoad[i] = 1.0
-                    - idleDiff / clockTicks / std::chrono::duration_cast<Sec>(timePoint - prevTimePoint).count();
-            }
-            prevIdleCpuStat = std::move(idleCpuStat);
-            prevTimePoint = timePoint;
+        std::vector<double> cpuLoad(::nCores);
+        if (sample(cpuLoad.data(), cpuLoad.size()).status == SampleInfo::OK)
             return cpuLoad;
-        }
         return {};
     }
+
+    SampleInfo sample(double* cpuLoad, std::size_t capacity) {
+        SampleInfo info;
+        if (capacity < ::nCores) {
+            // checked before reading, so the sample isn't lost
+            info.status = SampleInfo::BUFFER_TOO_SMALL;
+            info.size = ::nCores;
+            return info;
+        }
+        readIdleCpuStat();
+        if (recorder)
+            recorder->write(timePoint, idleCpuStat.data());
+        PhaseTimer timer{instrumentation, CounterInstrumentation::COMPUTE};
+        std::chrono::nanoseconds prevTimePoint = cpuLoadCalculator.getPrevTimePoint();
+        info.timestamp = std::chrono::steady_clock::time_point{
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(timePoint)};
+        if (cpuLoadCalculator.update(idleCpuStat.data(), timePoint, cpuLoad)) {
+            info.status = SampleInfo::OK;
+            info.size = ::nCores;
+            info.interval = timePoint - prevTimePoint;
+        }
+        return info;
+    }
+
+    void startRecording(const std::string& path) {
+        recorder.reset(new SampleRecorder(path, SampleKind::IDLE_JIFFIES, ::nCores, clockTicks));
+        // the baseline the next sample is computed against
+        recorder->write(cpuLoadCalculator.getPrevTimePoint(), cpuLoadCalculator.getPrevIdleCpuStat());
+    }
+
+    void stopRecording() {
+        recorder.reset();
+    }
+
 private:
-    std::vector<unsigned long> prevIdleCpuStat;
-    std::chrono::steady_clock::time_point prevTimePoint;
+    void readIdleCpuStat() {
+        procStat.update();
+        for (std::size_t i = 0; i < ::nCores; ++i) {
+            idleCpuStat[i] = procStat.getIdleJiffies(i);
+        }
+        timePoint = std::chrono::steady_clock::now().time_since_epoch();
+    }
+
+    ProcStatParser procStat;
+    std::vector<unsigned long long> idleCpuStat;
+    std::chrono::nanoseconds timePoint;
+    CpuLoadCalculator cpuLoadCalculator;
+    std::unique_ptr<SampleRecorder> recorder;
+    CounterInstrumentation& instrumentation;
 };
 
 #else
@@ -179,6 +227,11 @@ const std::size_t nCores{0};
 class CpuMonitor::PerformanceCounterImpl {
 public:
     std::vector<double> getCpuLoad() {return {};};
+    SampleInfo sample(double*, std::size_t) {return {};}
+    void startRecording(const std::string&) {
+        throw std::runtime_error("Recording of raw CPU counters is not implemented");
+    }
+    void stopRecording() {}
 };
 #endif
 CpuPerformanceCounter::CpuPerformanceCounter(int numCores) : nCores(numCores >= 0 ? numCores : 0), ov::monitor::PerformanceCounter("CPU") {}
@@ -190,5 +243,19 @@ std::vector<double> CpuPerformanceCounter::getLoad() {
         performanceCounter = new PerformanceCounterImpl();
     return performanceCounter->getCpuLoad();
 }
+SampleInfo CpuPerformanceCounter::sample(double* load, std::size_t capacity) {
+    if (!performanceCounter)
+        performanceCounter = new PerformanceCounterImpl();
+    return performanceCounter->sample(load, capacity);
+}
+void CpuPerformanceCounter::startRecording(const std::string& path) {
+    if (!performanceCounter)
+        performanceCounter = new PerformanceCounterImpl();
+    performanceCounter->startRecording(path);
+}
+void CpuPerformanceCounter::stopRecording() {
+    if (performanceCounter)
+        performanceCounter->stopRecording();
+}
 }
 }
\ No newline at end of file
@@ -0,0 +1,133 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <algorithm>
+#include "monitors/performance_counter.h"
+#include "monitors/cpu_times_performance_counter.h"
+#ifdef __linux__
+#include <unistd.h>
+
+namespace ov {
+namespace monitor {
+class CpuTimesPerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl() :
+        nCores(sysconf(_SC_NPROCESSORS_CONF)),
+        procStat{nCores},
+        prevJiffies(ProcStatParser::COLUMNS_NUMBER * nCores),
+        deltas(ProcStatParser::COLUMNS_NUMBER * nCores),
+        nextDeltas(ProcStatParser::COLUMNS_NUMBER * nCores),
+        ratios(ProcStatParser::COLUMNS_NUMBER * nCores),
+        totalDeltas(nCores) {
+        procStat.update();
+        std::copy(procStat.getColumn(ProcStatParser::USER), procStat.getColumn(ProcStatParser::USER) + prevJiffies.size(),
+                  prevJiffies.begin());
+    }
+
+    std::vector<double> getCpuTimes() {
+        procStat.update();
+        const unsigned long long* jiffies = procStat.getColumn(ProcStatParser::USER);
+        // the deltas of the last returned sample stay untouched until this one is complete
+        for (std::size_t i = 0; i < nextDeltas.size(); ++i) {
+            // counters of an offline core restart from 0
+            nextDeltas[i] = jiffies[i] >= prevJiffies[i] ? jiffies[i] - prevJiffies[i] : 0;
+        }
+        // guest and guest_nice are already included into user and nice
+        std::fill(totalDeltas.begin(), totalDeltas.end(), 0);
+        unsigned long long allCoresDelta = 0;
+        for (std::size_t column = ProcStatParser::USER; column <= ProcStatParser::STEAL; ++column) {
+            const unsigned long long* columnDeltas = nextDeltas.data() + column * nCores;
+            for (std::size_t core = 0; core < nCores; ++core)
+                totalDeltas[core] += columnDeltas[core];
+        }
+        for (std::size_t core = 0; core < nCores; ++core)
+            allCoresDelta += totalDeltas[core];
+        if (allCoresDelta == 0)
+            return {};
+
+        deltas.swap(nextDeltas);
+        for (std::size_t column = 0; column < ProcStatParser::COLUMNS_NUMBER; ++column) {
+            const unsigned long long* columnDeltas = deltas.data() + column * nCores;
+            double* columnRatios = ratios.data() + column * nCores;
+            for (std::size_t core = 0; core < nCores; ++core) {
+                columnRatios[core] = totalDeltas[core] ? static_cast<double>(columnDeltas[core]) / totalDeltas[core] : 0;
+            }
+        }
+        totalDelta = allCoresDelta;
+        std::copy(jiffies, jiffies + prevJiffies.size(), prevJiffies.begin());
+        return ratios;
+    }
+
+    std::size_t getNumberOfCores() const {
+        return nCores;
+    }
+
+    const unsigned long long* getDeltas(Column column) const {
+        return deltas.data() + column * nCores;
+    }
+
+    const double* getRatios(Column column) const {
+        return ratios.data() + column * nCores;
+    }
+
+    double getTotalRatio(Column column) const {
+        if (!totalDelta)
+            return 0;
+        const unsigned long long* columnDeltas = getDeltas(column);
+        unsigned long long sum = 0;
+        for (std::size_t core = 0; core < nCores; ++core)
+            sum += columnDeltas[core];
+        return static_cast<double>(sum) / totalDelta;
+    }
+
+private:
+    std::size_t nCores;
+    ProcStatParser procStat;
+    std::vector<unsigned long long> prevJiffies;
+    std::vector<unsigned long long> deltas;
+    std::vector<unsigned long long> nextDeltas;
+    std::vector<double> ratios;
+    std::vector<unsigned long long> totalDeltas;
+    unsigned long long totalDelta = 0;
+};
+
+#else
+// not implemented
+namespace ov {
+namespace monitor {
+class CpuTimesPerformanceCounter::PerformanceCounterImpl {
+public:
+    std::vector<double> getCpuTimes() {return {};}
+    std::size_t getNumberOfCores() const {return 0;}
+    const unsigned long long* getDeltas(Column) const {return NULL;}
+    const double* getRatios(Column) const {return NULL;}
+    double getTotalRatio(Column) const {return 0;}
+};
+#endif
+CpuTimesPerformanceCounter::CpuTimesPerformanceCounter() : ov::monitor::PerformanceCounter("CPU", "CPU times") {}
+CpuTimesPerformanceCounter::~CpuTimesPerformanceCounter() {
+    delete performanceCounter;
+}
+CpuTimesPerformanceCounter::PerformanceCounterImpl& CpuTimesPerformanceCounter::impl() {
+    if (!performanceCounter)
+        performanceCounter = new PerformanceCounterImpl();
+    return *performanceCounter;
+}
+std::vector<double> CpuTimesPerformanceCounter::getLoad() {
+    return impl().getCpuTimes();
+}
+std::size_t CpuTimesPerformanceCounter::getNumberOfCores() {
+    return impl().getNumberOfCores();
+}
+const unsigned long long* CpuTimesPerformanceCounter::getDeltas(Column column) {
+    return impl().getDeltas(column);
+}
+const double* CpuTimesPerformanceCounter::getRatios(Column column) {
+    return impl().getRatios(column);
+}
+double CpuTimesPerformanceCounter::getTotalRatio(Column column) {
+    return impl().getTotalRatio(column);
+}
+}
+}
@@ -0,0 +1,149 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/cpu_topology.h"
+
+#include <algorithm>
+#include <map>
+#ifdef __linux__
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <dirent.h>
+
+namespace {
+std::string readFirstLine(const std::string& path) {
+    std::ifstream file{path};
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+// "0-3,8,10-11"
+std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    const char* p = list.c_str();
+    while (*p >= '0' && *p <= '9') {
+        char* end;
+        long first = std::strtol(p, &end, 10);
+        long last = first;
+        if (*end == '-')
+            last = std::strtol(end + 1, &end, 10);
+        for (long cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(static_cast<int>(cpu));
+        p = *end == ',' ? end + 1 : end;
+    }
+    return cpus;
+}
+
+std::vector<int> listNumberedEntries(const std::string& path, const char* prefix) {
+    std::vector<int> ids;
+    std::size_t length = std::strlen(prefix);
+    if (DIR* dir = opendir(path.c_str())) {
+        while (dirent* entry = readdir(dir)) {
+            const char* name = entry->d_name;
+            if (std::strncmp(name, prefix, length) == 0 && name[length] >= '0' && name[length] <= '9'
+                && std::strspn(name + length, "0123456789") == std::strlen(name + length))
+                ids.push_back(std::atoi(name + length));
+        }
+        closedir(dir);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+// The shared_cpu_list of the highest level cache, the CPU itself if there is no cache information.
+std::string readLlcCpus(const std::string& cpuPath, int cpu) {
+    int bestLevel = -1;
+    std::string cpus = std::to_string(cpu);
+    for (int index : listNumberedEntries(cpuPath + "/cache", "index")) {
+        std::string indexPath = cpuPath + "/cache/index" + std::to_string(index);
+        if (readFirstLine(indexPath + "/type") == "Instruction")
+            continue;
+        int level = std::atoi(readFirstLine(indexPath + "/level").c_str());
+        if (level > bestLevel) {
+            bestLevel = level;
+            cpus = readFirstLine(indexPath + "/shared_cpu_list");
+        }
+    }
+    return cpus;
+}
+}
+#endif
+
+namespace ov {
+namespace monitor {
+CpuTopology::CpuTopology(const std::string& sysfsRoot) :
+    domainIds(LEVELS_NUMBER), domainSizes(LEVELS_NUMBER) {
+#ifdef __linux__
+    const std::string cpusPath = sysfsRoot + "/devices/system/cpu";
+    std::vector<int> cpus = listNumberedEntries(cpusPath, "cpu");
+    nCpus = cpus.empty() ? 0 : cpus.back() + 1;
+    domains.assign(LEVELS_NUMBER * nCpus, -1);
+
+    std::vector<int> cpuNodes(nCpus, 0);
+    const std::string nodesPath = sysfsRoot + "/devices/system/node";
+    for (int node : listNumberedEntries(nodesPath, "node")) {
+        for (int cpu : parseCpuList(readFirstLine(nodesPath + "/node" + std::to_string(node) + "/cpulist"))) {
+            if (cpu >= 0 && static_cast<std::size_t>(cpu) < nCpus)
+                cpuNodes[cpu] = node;
+        }
+    }
+
+    // domains are keyed by the sysfs values and numbered in the order of their first CPU
+    std::map<std::string, int> keys[LEVELS_NUMBER];
+    for (int cpu : cpus) {
+        const std::string cpuPath = cpusPath + "/cpu" + std::to_string(cpu);
+        const std::string topologyPath = cpuPath + "/topology";
+        std::string package = readFirstLine(topologyPath + "/physical_package_id");
+        if (package.empty())
+            continue;  // offline
+        std::string siblings = readFirstLine(topologyPath + "/thread_siblings_list");
+        std::string levelKeys[LEVELS_NUMBER];
+        int levelIds[LEVELS_NUMBER];
+        levelKeys[CPU] = std::to_string(cpu);
+        levelIds[CPU] = cpu;
+        levelKeys[CORE] = siblings.empty() ? levelKeys[CPU] : siblings;
+        levelIds[CORE] = siblings.empty() ? cpu : parseCpuList(siblings).front();
+        levelKeys[LLC] = readLlcCpus(cpuPath, cpu);
+        std::vector<int> llcCpus = parseCpuList(levelKeys[LLC]);
+        levelIds[LLC] = llcCpus.empty() ? cpu : llcCpus.front();
+        levelKeys[NUMA_NODE] = std::to_string(cpuNodes[cpu]);
+        levelIds[NUMA_NODE] = cpuNodes[cpu];
+        levelKeys[SOCKET] = package;
+        levelIds[SOCKET] = std::atoi(package.c_str());
+        for (int level = 0; level < LEVELS_NUMBER; ++level) {
+            auto inserted = keys[level].insert(std::make_pair(levelKeys[level], static_cast<int>(domainIds[level].size())));
+            if (inserted.second) {
+                domainIds[level].push_back(levelIds[level]);
+                domainSizes[level].push_back(0);
+            }
+            domains[level * nCpus + cpu] = inserted.first->second;
+            ++domainSizes[level][inserted.first->second];
+        }
+    }
+#endif
+}
+
+std::size_t CpuTopology::getNumberOfCpus() const {
+    return nCpus;
+}
+
+std::size_t CpuTopology::getNumberOfDomains(Level level) const {
+    return domainIds[level].size();
+}
+
+int CpuTopology::getDomain(Level level, std::size_t cpu) const {
+    return cpu < nCpus ? domains[level * nCpus + cpu] : -1;
+}
+
+int CpuTopology::getDomainId(Level level, std::size_t domain) const {
+    return domainIds[level][domain];
+}
+
+std::size_t CpuTopology::getDomainSize(Level level, std::size_t domain) const {
+    return domainSizes[level][domain];
+}
+}
+}
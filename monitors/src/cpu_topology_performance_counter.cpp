@@ -0,0 +1,79 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/cpu_topology_performance_counter.h"
+
+#include <algorithm>
+
+namespace {
+// sums accumulated from deltas drift, they are recomputed from scratch that often
+const unsigned resyncPeriod = 1024;
+}
+
+namespace ov {
+namespace monitor {
+CpuTopologyPerformanceCounter::CpuTopologyPerformanceCounter(
+    const std::shared_ptr<ov::monitor::PerformanceCounter>& perCpuCounter, const std::string& sysfsRoot) :
+    ov::monitor::PerformanceCounter("CPU", "CPU topology"), perCpuCounter{perCpuCounter}, topology{sysfsRoot} {
+    offsets[0] = 0;
+    for (int level = 0; level < CpuTopology::LEVELS_NUMBER; ++level)
+        offsets[level + 1] = offsets[level] + topology.getNumberOfDomains(static_cast<CpuTopology::Level>(level));
+    sums.resize(offsets[CpuTopology::LEVELS_NUMBER], 0.0);
+    loads.resize(offsets[CpuTopology::LEVELS_NUMBER], 0.0);
+}
+
+std::vector<double> CpuTopologyPerformanceCounter::getLoad() {
+    std::vector<double> cpuLoad = perCpuCounter->getLoad();
+    if (cpuLoad.empty())
+        return cpuLoad;
+    std::size_t nCpus = std::min(cpuLoad.size(), topology.getNumberOfCpus());
+    if (prevCpuLoad.size() != nCpus || ++updatesNumber % resyncPeriod == 0) {
+        prevCpuLoad.assign(cpuLoad.begin(), cpuLoad.begin() + nCpus);
+        resync(cpuLoad);
+    } else {
+        for (std::size_t cpu = 0; cpu < nCpus; ++cpu) {
+            double delta = cpuLoad[cpu] - prevCpuLoad[cpu];
+            if (delta == 0)
+                continue;
+            prevCpuLoad[cpu] = cpuLoad[cpu];
+            for (int level = 0; level < CpuTopology::LEVELS_NUMBER; ++level) {
+                int domain = topology.getDomain(static_cast<CpuTopology::Level>(level), cpu);
+                if (domain >= 0)
+                    sums[offsets[level] + domain] += delta;
+            }
+        }
+    }
+    for (int level = 0; level < CpuTopology::LEVELS_NUMBER; ++level) {
+        for (std::size_t domain = 0; domain < offsets[level + 1] - offsets[level]; ++domain) {
+            std::size_t size = topology.getDomainSize(static_cast<CpuTopology::Level>(level), domain);
+            loads[offsets[level] + domain] = size ? sums[offsets[level] + domain] / size : 0;
+        }
+    }
+    return loads;
+}
+
+void CpuTopologyPerformanceCounter::resync(const std::vector<double>& cpuLoad) {
+    std::fill(sums.begin(), sums.end(), 0.0);
+    for (std::size_t cpu = 0; cpu < prevCpuLoad.size(); ++cpu) {
+        for (int level = 0; level < CpuTopology::LEVELS_NUMBER; ++level) {
+            int domain = topology.getDomain(static_cast<CpuTopology::Level>(level), cpu);
+            if (domain >= 0)
+                sums[offsets[level] + domain] += cpuLoad[cpu];
+        }
+    }
+}
+
+const CpuTopology& CpuTopologyPerformanceCounter::getTopology() const {
+    return topology;
+}
+
+std::size_t CpuTopologyPerformanceCounter::getOffset(CpuTopology::Level level) const {
+    return offsets[level];
+}
+
+const double* CpuTopologyPerformanceCounter::getLoad(CpuTopology::Level level) const {
+    return loads.data() + offsets[level];
+}
+}
+}
@@ -5,63 +5,311 @@
 #include "monitors/device_monitor.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
+
+namespace {
+// longer than any counter waits between samples, see collectData()
+const std::chrono::seconds noDataTimeout{1};
+// getSamplingRate() follows the rate of the last few seconds rather than the average since the start
+const std::chrono::seconds rateWindow{5};
+}
 
 namespace ov {
 namespace monitor {
 DeviceMonitor::DeviceMonitor(const std::shared_ptr<ov::monitor::PerformanceCounter>& performanceCounter, unsigned historySize) :
-    samplesNumber{0},
     historySize{historySize > 0 ? historySize : 1},
-    performanceCounter{performanceCounter} {
-        while (deviceLoadHistory.size() < historySize)
-            collectData();
+    deviceLoadHistory{this->historySize},
+    performanceCounter{performanceCounter},
+    instrumentation(Instrumentation::get(performanceCounter->getCounterName())) {
+        collectData();
+    }
+
+DeviceMonitor::DeviceMonitor(const std::shared_ptr<ov::monitor::PerformanceCounter>& performanceCounter, unsigned historySize,
+                             std::chrono::milliseconds samplingPeriod) :
+    historySize{historySize > 0 ? historySize : 1},
+    deviceLoadHistory{this->historySize},
+    performanceCounter{performanceCounter},
+    instrumentation(Instrumentation::get(performanceCounter->getCounterName())) {
+        startSampling(samplingPeriod);
     }
 
-DeviceMonitor::~DeviceMonitor() = default;
+DeviceMonitor::DeviceMonitor(const std::shared_ptr<ov::monitor::PerformanceCounter>& performanceCounter, unsigned historySize,
+                             const AdaptiveSampling& adaptiveSampling) :
+    historySize{historySize > 0 ? historySize : 1},
+    deviceLoadHistory{this->historySize},
+    performanceCounter{performanceCounter},
+    instrumentation(Instrumentation::get(performanceCounter->getCounterName())) {
+        startSampling(adaptiveSampling);
+    }
+
+DeviceMonitor::~DeviceMonitor() {
+    stopSampling();
+}
 
 void DeviceMonitor::setHistorySize(std::size_t size) {
+    std::lock_guard<std::mutex> lock{mutex};
     historySize = size > 0 ? size : 1;
-    std::ptrdiff_t newSize = static_cast<std::ptrdiff_t>(std::min(size, deviceLoadHistory.size()));
-    deviceLoadHistory.erase(deviceLoadHistory.begin(), deviceLoadHistory.end() - newSize);
+    deviceLoadHistory.setCapacity(historySize);
 }
 
 void DeviceMonitor::collectData() {
-    samplesNumber = 0;
-    deviceLoadHistory.clear();
-    while(deviceLoadHistory.size() < historySize) {
-        std::vector<double> deviceLoad = performanceCounter->getLoad();
-        if (deviceLoadSum.empty())
-            deviceLoadSum.resize(deviceLoad.size(), 0.0);
-        if (!deviceLoad.empty()) {
-            for (std::size_t i = 0; i < deviceLoad.size(); ++i) {
-                if (deviceLoadHistory.size() == 0)
-                    deviceLoadSum[i] = 0.0;
-                if (historySize > 1)
-                    deviceLoadSum[i] += deviceLoad[i];
-                else
-                    deviceLoadSum[i] = deviceLoad[i];
-            }
-            ++samplesNumber;
-            deviceLoadHistory.push_back(std::move(deviceLoad));
+    if (sampler.joinable()) {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (samplingError)
+            std::rethrow_exception(samplingError);
+        return;
+    }
+    std::size_t samplesNumber = deviceLoadHistory.full() ? 1 : historySize - deviceLoadHistory.size();
+    auto deadline = std::chrono::steady_clock::now() + noDataTimeout;
+    while (samplesNumber > 0) {
+        SampleInfo info = takeSample();
+        if (info.status != SampleInfo::OK) {
+            // counters without devices or unsupported on this system never have data
+            if (std::chrono::steady_clock::now() >= deadline)
+                return;
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            continue;
+        }
+        std::shared_ptr<AlertEngine> engine;
+        std::size_t device;
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            pushSample(info);
+            engine = alertEngine;
+            device = alertDevice;
         }
+        if (engine)
+            engine->evaluate(device, sampleBuffer.data(), info.size, info);
+        --samplesNumber;
+        deadline = std::chrono::steady_clock::now() + noDataTimeout;
     }
 }
 
 std::size_t DeviceMonitor::getHistorySize() const {
+    std::lock_guard<std::mutex> lock{mutex};
     return historySize;
 }
 
 std::deque<std::vector<double>> DeviceMonitor::getLastHistory() const {
-    return deviceLoadHistory;
+    std::lock_guard<std::mutex> lock{mutex};
+    std::deque<std::vector<double>> history;
+    for (std::size_t sample = 0; sample < deviceLoadHistory.size(); ++sample) {
+        std::vector<double> deviceLoad(deviceLoadHistory.getNumberOfCores());
+        for (std::size_t core = 0; core < deviceLoad.size(); ++core)
+            deviceLoad[core] = deviceLoadHistory.at(sample, core);
+        history.push_back(std::move(deviceLoad));
+    }
+    return history;
+}
+
+DeviceMonitor::HistoryView DeviceMonitor::getHistoryView() const {
+    return HistoryView{std::unique_lock<std::mutex>{mutex}, deviceLoadHistory, lastSampleInfo};
 }
 
 std::vector<double> DeviceMonitor::getMeanDeviceLoad() const {
-    std::vector<double> meanDeviceLoad;
-    meanDeviceLoad.reserve(deviceLoadSum.size());
-    for (double coreLoad : deviceLoadSum) {
-        meanDeviceLoad.push_back(samplesNumber ? coreLoad / samplesNumber : 0);
+    std::lock_guard<std::mutex> lock{mutex};
+    std::vector<double> meanDeviceLoad(deviceLoadHistory.getNumberOfCores());
+    for (std::size_t core = 0; core < meanDeviceLoad.size(); ++core) {
+        meanDeviceLoad[core] = deviceLoadHistory.getMean(core);
     }
     return meanDeviceLoad;
 }
+
+void DeviceMonitor::startSampling(std::chrono::milliseconds period) {
+    startSamplingThread(period, nullptr);
+}
+
+void DeviceMonitor::startSampling(const AdaptiveSampling& config) {
+    if (config.minPeriod < std::chrono::milliseconds{1} || config.maxPeriod < config.minPeriod) {
+        throw std::invalid_argument("Adaptive sampling needs 1 ms <= minPeriod <= maxPeriod");
+    }
+    if (config.backoff < 1) {
+        throw std::invalid_argument("The backoff of adaptive sampling must be at least 1");
+    }
+    startSamplingThread(config.minPeriod, &config);
+}
+
+void DeviceMonitor::startSamplingThread(std::chrono::milliseconds period, const AdaptiveSampling* config) {
+    stopSampling();
+    std::lock_guard<std::mutex> lock{mutex};
+    samplingPeriod = std::max(period, std::chrono::milliseconds{1});
+    adaptive = config != nullptr;
+    if (config)
+        adaptiveSampling = *config;
+    stopRequested = false;
+    samplingError = nullptr;
+    samplingStart = std::chrono::steady_clock::now();
+    sampleTimes.clear();
+    sampler = std::thread{&DeviceMonitor::samplingLoop, this};
+}
+
+void DeviceMonitor::stopSampling() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (!sampler.joinable())
+            return;
+        stopRequested = true;
+    }
+    wakeUp.notify_all();
+    sampler.join();
+}
+
+bool DeviceMonitor::isSampling() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return sampler.joinable() && !stopRequested && !samplingError;
+}
+
+std::chrono::milliseconds DeviceMonitor::getSamplingPeriod() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return samplingPeriod;
+}
+
+double DeviceMonitor::getSamplingRate() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    auto now = std::chrono::steady_clock::now();
+    // the window is shorter right after the start
+    auto windowStart = std::max(now - rateWindow, samplingStart);
+    typedef std::chrono::duration<double, std::chrono::seconds::period> Sec;
+    double elapsed = std::chrono::duration_cast<Sec>(now - windowStart).count();
+    if (!sampler.joinable() || elapsed <= 0)
+        return 0;
+    // older times are only dropped by the next sample
+    auto first = std::lower_bound(sampleTimes.begin(), sampleTimes.end(), windowStart);
+    return (sampleTimes.end() - first) / elapsed;
+}
+
+void DeviceMonitor::setSnapshotPublisher(const std::shared_ptr<SnapshotPublisher>& publisher, std::size_t device) {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (publisher && device >= publisher->getMaxDevices()) {
+        throw std::out_of_range("The device doesn't fit into the snapshot segment");
+    }
+    snapshotPublisher = publisher;
+    snapshotDevice = device;
+    deviceName = performanceCounter->name();
+    if (snapshotPublisher)
+        snapshotPublisher->publish(snapshotDevice, deviceName, deviceLoadHistory);
+}
+
+void DeviceMonitor::setAlertEngine(const std::shared_ptr<AlertEngine>& engine, std::size_t device) {
+    std::lock_guard<std::mutex> lock{mutex};
+    alertEngine = engine;
+    alertDevice = device;
+}
+
+SampleInfo DeviceMonitor::getLastSampleInfo() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return lastSampleInfo;
+}
+
+void DeviceMonitor::samplingLoop() {
+    std::unique_lock<std::mutex> lock{mutex};
+    auto nextTick = std::chrono::steady_clock::now();
+    while (!stopRequested) {
+        lock.unlock();
+        // the counter may sleep or read procfs, readers must not wait for it
+        SampleInfo info;
+        std::exception_ptr error;
+        try {
+            info = takeSample();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // the CPU time of the threads calling collectData() would be mostly theirs
+        if (Instrumentation::isEnabled())
+            instrumentation.setThreadCpuTime(Instrumentation::getThreadCpuTime());
+        lock.lock();
+        if (error) {
+            samplingError = error;
+            return;
+        }
+        if (info.status == SampleInfo::OK) {
+            if (adaptive)
+                adaptSamplingPeriod(info);
+            pushSample(info);
+            sampleTimes.push_back(std::chrono::steady_clock::now());
+            while (sampleTimes.front() < sampleTimes.back() - rateWindow)
+                sampleTimes.pop_front();
+            if (alertEngine) {
+                // callbacks may call the monitor getters
+                std::shared_ptr<AlertEngine> engine = alertEngine;
+                std::size_t device = alertDevice;
+                lock.unlock();
+                engine->evaluate(device, sampleBuffer.data(), info.size, info);
+                lock.lock();
+                if (stopRequested)
+                    return;
+            }
+        }
+
+        nextTick += samplingPeriod;
+        auto now = std::chrono::steady_clock::now();
+        if (nextTick < now)
+            nextTick = now + samplingPeriod;
+        wakeUp.wait_until(lock, nextTick, [this] { return stopRequested; });
+    }
+}
+
+SampleInfo DeviceMonitor::takeSample() {
+    PhaseTimer timer{instrumentation, CounterInstrumentation::TOTAL};
+    bool instrumented = Instrumentation::isEnabled();
+    SampleInfo info;
+    try {
+        info = performanceCounter->sample(sampleBuffer.data(), sampleBuffer.size());
+        while (info.status == SampleInfo::BUFFER_TOO_SMALL) {
+            if (instrumented)
+                instrumentation.count(CounterInstrumentation::BUFFER_TOO_SMALL);
+            sampleBuffer.resize(info.size);
+            info = performanceCounter->sample(sampleBuffer.data(), sampleBuffer.size());
+        }
+    } catch (...) {
+        if (instrumented)
+            instrumentation.count(CounterInstrumentation::ERRORS);
+        throw;
+    }
+    if (instrumented) {
+        instrumentation.count(info.status == SampleInfo::OK ? CounterInstrumentation::SAMPLES
+                                                            : CounterInstrumentation::NO_DATA);
+    }
+    return info;
+}
+
+void DeviceMonitor::adaptSamplingPeriod(const SampleInfo& info) {
+    bool volatileLoad = false;
+    std::size_t last = deviceLoadHistory.size();
+    if (last == 0 || deviceLoadHistory.getNumberOfCores() != info.size) {
+        volatileLoad = true;
+    } else {
+        for (std::size_t core = 0; core < info.size && !volatileLoad; ++core) {
+            double prev = deviceLoadHistory.at(last - 1, core);
+            double load = sampleBuffer[core];
+            if (std::abs(load - prev) > adaptiveSampling.changeThreshold)
+                volatileLoad = true;
+            for (double band : adaptiveSampling.bands) {
+                if ((prev < band) != (load < band))
+                    volatileLoad = true;
+            }
+        }
+    }
+    if (volatileLoad) {
+        samplingPeriod = adaptiveSampling.minPeriod;
+    } else {
+        // rounded up, so that short periods grow with a backoff below 2 too
+        std::chrono::milliseconds period{static_cast<std::chrono::milliseconds::rep>(
+            std::ceil(samplingPeriod.count() * adaptiveSampling.backoff))};
+        samplingPeriod = std::min(period, adaptiveSampling.maxPeriod);
+    }
+}
+
+void DeviceMonitor::pushSample(const SampleInfo& info) {
+    // the storage is only reallocated when the number of cores changes
+    if (deviceLoadHistory.getNumberOfCores() != info.size)
+        deviceLoadHistory.reset(historySize, info.size);
+    deviceLoadHistory.push(sampleBuffer.data());
+    lastSampleInfo = info;
+    if (snapshotPublisher)
+        snapshotPublisher->publish(snapshotDevice, deviceName, deviceLoadHistory);
+}
 }
 }
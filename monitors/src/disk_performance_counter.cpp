@@ -0,0 +1,236 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <algorithm>
+#include "monitors/performance_counter.h"
+#include "monitors/disk_performance_counter.h"
+#ifdef __linux__
+#include <chrono>
+#include <cstring>
+#include <unistd.h>
+#include "monitors/instrumentation.h"
+#include "named_rows.h"
+#include "proc_file.h"
+
+namespace {
+// /proc/diskstats columns after the device name
+enum DiskstatsField {
+    READS = 0,
+    READS_MERGED,
+    SECTORS_READ,
+    MS_READING,
+    WRITES,
+    WRITES_MERGED,
+    SECTORS_WRITTEN,
+    MS_WRITING,
+    IOS_IN_PROGRESS,
+    MS_IO,
+    WEIGHTED_MS_IO,
+    DISKSTATS_FIELDS_NUMBER
+};
+
+const double sectorSize = 512;  // diskstats always counts 512-byte sectors
+// diskstats counts times in ms, shorter intervals would be mostly rounding
+const std::chrono::milliseconds minInterval{5};
+
+const char* skipBlanks(const char* p) {
+    while (*p == ' ' || *p == '\t')
+        ++p;
+    return p;
+}
+
+const char* skipToken(const char* p) {
+    while (*p && *p != ' ' && *p != '\t' && *p != '\n')
+        ++p;
+    return p;
+}
+
+// "   8       0 sda 4530 1276 ..."
+const char* parseName(const char* line, const char*& name, const char*& nameEnd) {
+    name = skipBlanks(skipToken(skipBlanks(skipToken(skipBlanks(line)))));
+    nameEnd = skipToken(name);
+    return nameEnd != name ? nameEnd : NULL;
+}
+}
+
+namespace ov {
+namespace monitor {
+class DiskPerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl(unsigned filter, const std::vector<std::string>& excludedPrefixes,
+                           const std::string& procfsRoot, const std::string& sysfsRoot) :
+        filter{filter}, excludedPrefixes(excludedPrefixes), sysfsRoot{sysfsRoot},
+        diskstats{procfsRoot + "/diskstats", 16384} {
+        hasSysfsBlock = access((sysfsRoot + "/block").c_str(), F_OK) == 0;
+        readDiskstats();
+        prevTimePoint = std::chrono::steady_clock::now();
+    }
+
+    std::vector<double> getDiskLoad() {
+        if (!update())
+            return {};
+        return diskLoad;
+    }
+
+    SampleInfo sample(double* load, std::size_t capacity) {
+        SampleInfo info;
+        if (!unsent) {
+            // checked against the known rows before reading, so the sample isn't lost
+            if (rows.getNames().size() > capacity) {
+                info.status = SampleInfo::BUFFER_TOO_SMALL;
+                info.size = rows.getNames().size();
+                return info;
+            }
+            if (!update())
+                return info;
+        }
+        info.timestamp = prevTimePoint;
+        info.interval = interval;
+        info.size = diskLoad.size();
+        // rows appeared while reading: the sample is kept for the retry with a bigger buffer
+        unsent = diskLoad.size() > capacity;
+        if (unsent) {
+            info.status = SampleInfo::BUFFER_TOO_SMALL;
+            return info;
+        }
+        std::copy(diskLoad.begin(), diskLoad.end(), load);
+        info.status = SampleInfo::OK;
+        return info;
+    }
+
+    const std::vector<std::string>& getDevices() const {
+        return rows.getNames();
+    }
+
+    double getMetric(Metric metric, std::size_t device) const {
+        return device < rows.getNames().size() && !metrics.empty() ? metrics[device * METRICS_NUMBER + metric] : 0;
+    }
+
+private:
+    typedef NamedRows<DISKSTATS_FIELDS_NUMBER> DiskRows;
+
+    // Sets the time the new metrics are computed over. Returns false without reading anything if the
+    // previous sample, or the baseline the constructor takes, is less than minInterval ago.
+    bool update() {
+        if (std::chrono::steady_clock::now() - prevTimePoint < minInterval)
+            return false;
+        unsent = false;
+        readDiskstats();
+        auto timePoint = std::chrono::steady_clock::now();
+        interval = timePoint - prevTimePoint;
+        typedef std::chrono::duration<double, std::milli> Ms;
+        double elapsed = std::chrono::duration_cast<Ms>(interval).count();
+        prevTimePoint = timePoint;
+
+        PhaseTimer timer{instrumentation, CounterInstrumentation::COMPUTE};
+        // assign() keeps the storage, so sampling doesn't allocate while the devices stay the same
+        metrics.assign(rows.getNames().size() * METRICS_NUMBER, 0.0);
+        diskLoad.assign(rows.getNames().size(), 0.0);
+        for (const DiskRows::Row& row : rows.getRows()) {
+            if (!row.included)
+                continue;
+            double deltas[DISKSTATS_FIELDS_NUMBER];
+            for (int field = 0; field < DISKSTATS_FIELDS_NUMBER; ++field) {
+                deltas[field] = row.values[field] >= row.prevValues[field]
+                    ? static_cast<double>(row.values[field] - row.prevValues[field]) : 0;
+            }
+            double* metric = metrics.data() + row.index * METRICS_NUMBER;
+            if (elapsed > 0) {
+                metric[READ_BYTES] = deltas[SECTORS_READ] * sectorSize * 1000 / elapsed;
+                metric[WRITE_BYTES] = deltas[SECTORS_WRITTEN] * sectorSize * 1000 / elapsed;
+                metric[READ_IOPS] = deltas[READS] * 1000 / elapsed;
+                metric[WRITE_IOPS] = deltas[WRITES] * 1000 / elapsed;
+                metric[UTILIZATION] = std::min(1.0, deltas[MS_IO] / elapsed);
+                metric[QUEUE_SIZE] = deltas[WEIGHTED_MS_IO] / elapsed;
+            }
+            metric[READ_LATENCY] = deltas[READS] > 0 ? deltas[MS_READING] / deltas[READS] : 0;
+            metric[WRITE_LATENCY] = deltas[WRITES] > 0 ? deltas[MS_WRITING] / deltas[WRITES] : 0;
+            diskLoad[row.index] = metric[UTILIZATION];
+        }
+        return true;
+    }
+
+    void readDiskstats() {
+        std::size_t size;
+        const char* data;
+        {
+            PhaseTimer timer{instrumentation, CounterInstrumentation::READ};
+            data = diskstats.read(size);
+        }
+        PhaseTimer timer{instrumentation, CounterInstrumentation::PARSE};
+        rows.read(data, parseName, [this](const std::string& name) { return isIncluded(name); });
+    }
+
+    bool isIncluded(const std::string& name) const {
+        for (const std::string& prefix : excludedPrefixes) {
+            if (name.compare(0, prefix.size(), prefix) == 0)
+                return false;
+        }
+        if (filter & NO_VIRTUAL && (name.compare(0, 4, "loop") == 0 || name.compare(0, 3, "ram") == 0))
+            return false;
+        if (filter & NO_PARTITIONS && hasSysfsBlock) {
+            // sysfs replaces '/' of names like cciss/c0d0 with '!'
+            std::string sysfsName = name;
+            std::replace(sysfsName.begin(), sysfsName.end(), '/', '!');
+            if (access((sysfsRoot + "/block/" + sysfsName).c_str(), F_OK) != 0)
+                return false;
+        }
+        return true;
+    }
+
+    unsigned filter;
+    std::vector<std::string> excludedPrefixes;
+    std::string sysfsRoot;
+    bool hasSysfsBlock;
+    ProcFile diskstats;
+    DiskRows rows;
+    std::vector<double> metrics;
+    std::vector<double> diskLoad;
+    CounterInstrumentation& instrumentation = Instrumentation::get("Disk");
+    std::chrono::steady_clock::time_point prevTimePoint;
+    std::chrono::nanoseconds interval{0};
+    bool unsent = false;  // the last sample didn't fit into the caller's buffer
+};
+
+#else
+// not implemented
+namespace ov {
+namespace monitor {
+class DiskPerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl(unsigned, const std::vector<std::string>&, const std::string&, const std::string&) {}
+    std::vector<double> getDiskLoad() {return {};}
+    SampleInfo sample(double*, std::size_t) {return {};}
+    const std::vector<std::string>& getDevices() const {return devices;}
+    double getMetric(Metric, std::size_t) const {return 0;}
+private:
+    std::vector<std::string> devices;
+};
+#endif
+DiskPerformanceCounter::DiskPerformanceCounter(unsigned filter, const std::vector<std::string>& excludedPrefixes,
+                                               const std::string& procfsRoot, const std::string& sysfsRoot) :
+    ov::monitor::PerformanceCounter("Disk"), filter{filter}, excludedPrefixes(excludedPrefixes),
+    procfsRoot{procfsRoot}, sysfsRoot{sysfsRoot} {}
+DiskPerformanceCounter::~DiskPerformanceCounter() {
+    delete performanceCounter;
+}
+DiskPerformanceCounter::PerformanceCounterImpl& DiskPerformanceCounter::impl() {
+    if (!performanceCounter)
+        performanceCounter = new PerformanceCounterImpl(filter, excludedPrefixes, procfsRoot, sysfsRoot);
+    return *performanceCounter;
+}
+std::vector<double> DiskPerformanceCounter::getLoad() {
+    return impl().getDiskLoad();
+}
+SampleInfo DiskPerformanceCounter::sample(double* load, std::size_t capacity) {
+    return impl().sample(load, capacity);
+}
+const std::vector<std::string>& DiskPerformanceCounter::getDevices() {
+    return impl().getDevices();
+}
+double DiskPerformanceCounter::getMetric(Metric metric, std::size_t device) {
+    return impl().getMetric(metric, device);
+}
+}
+}
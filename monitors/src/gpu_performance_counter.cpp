@@ -7,6 +7,9 @@
 #include <sstream>
 #include "monitors/performance_counter.h"
 #include "monitors/gpu_performance_counter.h"
+#define RENDER_ENGINE_COUNTER_INDEX 0
+#define COMPUTE_ENGINE_COUNTER_INDEX 1
+#define MAX_COUNTER_INDEX 2
 #ifdef _WIN32
 #define NOMINMAX
 #include "query_wrapper.h"
@@ -19,15 +22,12 @@
 #include <pdh.h>
 #include <pdhmsg.h>
 #include <dxgi.h>
-#define RENDER_ENGINE_COUNTER_INDEX 0
-#define COMPUTE_ENGINE_COUNTER_INDEX 1
-#define MAX_COUNTER_INDEX 2
 
 namespace ov {
 namespace monitor {
 class GpuPerformanceCounter::PerformanceCounterImpl {
 public:
-    PerformanceCounterImpl() {
+    PerformanceCounterImpl(const std::string&, const std::string&) {
         auto devices = getNumberOfCores();
         coreTimeCounters.resize(devices.size());
         for (std::size_t i = 0; i < devices.size(); ++i) {
@@ -165,20 +165,328 @@ private:
 
 #elif __linux__
 #include <chrono>
-#include <regex>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <utility>
-#include <fstream>
+#include <dirent.h>
+#include <fcntl.h>
 #include <unistd.h>
 
+namespace {
+// Busy time of the render and compute engines is reported per DRM client in /proc/<pid>/fdinfo/<fd>
+// (drm-engine-render/drm-engine-compute, in ns), /sys/class/drm is used to discover the devices.
+struct DrmClientStat {
+    std::string pdev;
+    unsigned long long clientId = 0;
+    unsigned long long busy[MAX_COUNTER_INDEX] = {};
+    unsigned long long capacity[MAX_COUNTER_INDEX] = {1, 1};
+};
+
+bool startsWith(const char* str, const char* prefix) {
+    return strncmp(str, prefix, strlen(prefix)) == 0;
+}
+
+const char* skipBlanks(const char* p) {
+    while (*p == ' ' || *p == '\t')
+        ++p;
+    return p;
+}
+
+bool parseDrmFdinfo(const char* data, DrmClientStat& stat) {
+    static const char* const busyKeys[MAX_COUNTER_INDEX] = {"drm-engine-render:", "drm-engine-compute:"};
+    static const char* const capacityKeys[MAX_COUNTER_INDEX] = {"drm-engine-capacity-render:",
+                                                                "drm-engine-capacity-compute:"};
+    bool isDrm = false;
+    stat.pdev.clear();
+    stat.clientId = 0;
+    for (int i = 0; i < MAX_COUNTER_INDEX; ++i) {
+        stat.busy[i] = 0;
+        stat.capacity[i] = 1;
+    }
+    for (const char* line = data; *line; ) {
+        const char* lineEnd = strchr(line, '\n');
+        if (!lineEnd)
+            lineEnd = line + strlen(line);
+        if (startsWith(line, "drm-pdev:")) {
+            const char* value = skipBlanks(line + strlen("drm-pdev:"));
+            stat.pdev.assign(value, lineEnd);
+            isDrm = true;
+        } else if (startsWith(line, "drm-client-id:")) {
+            stat.clientId = strtoull(line + strlen("drm-client-id:"), NULL, 10);
+        } else {
+            for (int i = 0; i < MAX_COUNTER_INDEX; ++i) {
+                if (startsWith(line, busyKeys[i]))
+                    stat.busy[i] = strtoull(line + strlen(busyKeys[i]), NULL, 10);
+                else if (startsWith(line, capacityKeys[i]))
+                    stat.capacity[i] = std::max(1ULL, strtoull(line + strlen(capacityKeys[i]), NULL, 10));
+            }
+        }
+        line = *lineEnd ? lineEnd + 1 : lineEnd;
+    }
+    return isDrm;
+}
+
+bool isNumber(const char* str) {
+    if (!*str)
+        return false;
+    for (; *str; ++str) {
+        if (*str < '0' || *str > '9')
+            return false;
+    }
+    return true;
+}
+
+bool parseNumber(const std::string& str, int& number) {
+    if (!isNumber(str.c_str()))
+        return false;
+    number = std::atoi(str.c_str());
+    return true;
+}
+
+std::vector<std::string> listDirectory(const std::string& path) {
+    std::vector<std::string> entries;
+    DIR* dir = opendir(path.c_str());
+    if (!dir)
+        return entries;
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] != '.')
+            entries.push_back(entry->d_name);
+    }
+    closedir(dir);
+    return entries;
+}
+
+std::string readFirstLine(const std::string& path) {
+    char buffer[256];
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return {};
+    ssize_t size = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (size <= 0)
+        return {};
+    buffer[size] = 0;
+    return std::string(buffer, strcspn(buffer, "\n"));
+}
+}
+
 namespace ov {
 namespace monitor {
 class GpuPerformanceCounter::PerformanceCounterImpl {
 public:
-    PerformanceCounterImpl(){}
+    PerformanceCounterImpl(const std::string& sysfsRoot, const std::string& procfsRoot) : procfsRoot{procfsRoot} {
+        // cardN, skipping connectors like card0-DP-1; only Intel devices like on Windows
+        for (const std::string& card : listDirectory(sysfsRoot + "/class/drm")) {
+            if (!startsWith(card.c_str(), "card") || !isNumber(card.c_str() + 4))
+                continue;
+            std::string devicePath = sysfsRoot + "/class/drm/" + card + "/device";
+            if (readFirstLine(devicePath + "/vendor") != "0x8086")
+                continue;
+            char resolved[PATH_MAX];
+            if (!realpath(devicePath.c_str(), resolved))
+                continue;
+            const char* pdev = strrchr(resolved, '/');
+            devices.push_back(pdev ? pdev + 1 : resolved);
+        }
+        busyDeltas.resize(devices.size() * MAX_COUNTER_INDEX);
+        capacities.resize(devices.size() * MAX_COUNTER_INDEX, 1);
+        prevTimePoint = std::chrono::steady_clock::now();
+        rescanClients(true);
+        lastRescan = prevTimePoint;
+        lastFullRescan = prevTimePoint;
+    }
+
+    ~PerformanceCounterImpl() {
+        for (const DrmClient& client : clients)
+            close(client.fd);
+    }
 
     std::vector<double> getGpuLoad() {
-        return {0};
+        if (devices.empty()) {
+            // there is nothing to wait for, DeviceMonitor would retry {} for a second on every collectData()
+            return {0};
+        }
+        auto timePoint = std::chrono::steady_clock::now();
+        // the same rate limit as for the CPU: too short intervals make the ratio noisy
+        if (timePoint - prevTimePoint <= std::chrono::milliseconds{300})
+            return {};
+
+        std::fill(busyDeltas.begin(), busyDeltas.end(), 0);
+        sampleClients();
+        if (timePoint - lastRescan >= rescanPeriod) {
+            bool full = timePoint - lastFullRescan >= fullRescanPeriod;
+            rescanClients(full);
+            lastRescan = timePoint;
+            if (full)
+                lastFullRescan = timePoint;
+        }
+
+        typedef std::chrono::duration<double, std::nano> Ns;
+        double elapsed = std::chrono::duration_cast<Ns>(timePoint - prevTimePoint).count();
+        prevTimePoint = timePoint;
+        std::vector<double> gpuLoad(devices.size(), 0.0);
+        for (std::size_t device = 0; device < devices.size(); ++device) {
+            for (int counterIndex = 0; counterIndex < MAX_COUNTER_INDEX; ++counterIndex) {
+                std::size_t i = device * MAX_COUNTER_INDEX + counterIndex;
+                gpuLoad[device] += std::min(1.0, busyDeltas[i] / (elapsed * capacities[i]));
+            }
+        }
+        return gpuLoad;
     }
+
+private:
+    typedef std::pair<int, int> FdKey;  // pid, fd number
+
+    struct DrmClient {
+        int fd;
+        FdKey key;
+        std::size_t device;
+        unsigned long long clientId;
+        unsigned long long busy[MAX_COUNTER_INDEX];
+    };
+
+    // Re-reads the fdinfo of known clients and accumulates their busy time since the previous sample.
+    void sampleClients() {
+        std::size_t alive = 0;
+        for (std::size_t i = 0; i < clients.size(); ++i) {
+            DrmClient& client = clients[i];
+            ssize_t size = pread(client.fd, buffer, sizeof(buffer) - 1, 0);
+            if (size <= 0) {
+                // the process has exited or closed the fd
+                close(client.fd);
+                continue;
+            }
+            buffer[size] = 0;
+            std::size_t device = 0;
+            if (!parseDrmFdinfo(buffer, stat) || !findDevice(stat.pdev, device)) {
+                close(client.fd);
+                continue;
+            }
+            // the fd number was reused for another client, it is accounted from now on
+            bool reused = device != client.device || stat.clientId != client.clientId;
+            client.device = device;
+            client.clientId = stat.clientId;
+            for (int counterIndex = 0; counterIndex < MAX_COUNTER_INDEX; ++counterIndex) {
+                if (!reused && stat.busy[counterIndex] >= client.busy[counterIndex]) {
+                    busyDeltas[client.device * MAX_COUNTER_INDEX + counterIndex] +=
+                        stat.busy[counterIndex] - client.busy[counterIndex];
+                }
+                client.busy[counterIndex] = stat.busy[counterIndex];
+                capacities[client.device * MAX_COUNTER_INDEX + counterIndex] = stat.capacity[counterIndex];
+            }
+            if (alive != i)
+                clients[alive] = std::move(client);
+            ++alive;
+        }
+        clients.resize(alive);
+    }
+
+    // Finds the DRM fds of the processes started since the previous rescan, or of all processes for a full
+    // rescan, which catches the fds that running processes opened later. Known clients keep their fds, so only
+    // new fds are resolved and opened. A client shared by several fds is tracked once, through the first one
+    // found; the busy time of new clients is only accounted from now on.
+    void rescanClients(bool full) {
+        std::vector<int> pids;
+        int number;
+        for (const std::string& name : listDirectory(procfsRoot)) {
+            if (parseNumber(name, number))
+                pids.push_back(number);
+        }
+        std::sort(pids.begin(), pids.end());
+        std::vector<FdKey> tracked;
+        tracked.reserve(clients.size());
+        for (const DrmClient& client : clients)
+            tracked.push_back(client.key);
+        std::sort(tracked.begin(), tracked.end());
+        // the duplicates of the processes that aren't walked again stay known until they exit
+        std::vector<FdKey> duplicates;
+        for (const FdKey& key : duplicateKeys) {
+            if (!full && std::binary_search(pids.begin(), pids.end(), key.first)
+                    && std::binary_search(knownPids.begin(), knownPids.end(), key.first))
+                duplicates.push_back(key);
+        }
+        char target[64];
+        for (int pid : pids) {
+            if (!full && std::binary_search(knownPids.begin(), knownPids.end(), pid))
+                continue;
+            std::string pidPath = procfsRoot + "/" + std::to_string(pid);
+            for (const std::string& fdName : listDirectory(pidPath + "/fd")) {
+                if (!parseNumber(fdName, number))
+                    continue;
+                FdKey key{pid, number};
+                if (std::binary_search(tracked.begin(), tracked.end(), key))
+                    continue;
+                if (std::binary_search(duplicateKeys.begin(), duplicateKeys.end(), key)) {
+                    duplicates.push_back(key);
+                    continue;
+                }
+                ssize_t size = readlink((pidPath + "/fd/" + fdName).c_str(), target, sizeof(target) - 1);
+                if (size <= 0)
+                    continue;
+                target[size] = 0;
+                if (!startsWith(target, "/dev/dri/"))
+                    continue;
+                int fd = open((pidPath + "/fdinfo/" + fdName).c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0)
+                    continue;
+                DrmClient client = {fd, key, 0, 0, {}};
+                bool duplicate = false;
+                if (!readClient(client, duplicate)) {
+                    if (duplicate)
+                        duplicates.push_back(key);
+                    close(fd);
+                    continue;
+                }
+                clients.push_back(client);
+            }
+        }
+        // forget the fds that were closed since
+        std::sort(duplicates.begin(), duplicates.end());
+        duplicateKeys.swap(duplicates);
+        knownPids.swap(pids);
+    }
+
+    bool findDevice(const std::string& pdev, std::size_t& device) const {
+        std::vector<std::string>::const_iterator found = std::find(devices.begin(), devices.end(), pdev);
+        device = found - devices.begin();
+        return found != devices.end();
+    }
+
+    bool readClient(DrmClient& client, bool& duplicate) {
+        ssize_t size = pread(client.fd, buffer, sizeof(buffer) - 1, 0);
+        if (size <= 0)
+            return false;
+        buffer[size] = 0;
+        if (!parseDrmFdinfo(buffer, stat) || !findDevice(stat.pdev, client.device))
+            return false;
+        client.clientId = stat.clientId;
+        for (const DrmClient& other : clients) {
+            if (other.device == client.device && other.clientId == client.clientId) {
+                duplicate = true;
+                return false;
+            }
+        }
+        for (int counterIndex = 0; counterIndex < MAX_COUNTER_INDEX; ++counterIndex)
+            client.busy[counterIndex] = stat.busy[counterIndex];
+        return true;
+    }
+
+    std::string procfsRoot;
+    std::vector<std::string> devices;
+    std::vector<DrmClient> clients;
+    std::vector<FdKey> duplicateKeys;  // sorted
+    std::vector<int> knownPids;  // sorted, as of the previous rescan
+    std::vector<unsigned long long> busyDeltas;
+    std::vector<unsigned long long> capacities;
+    DrmClientStat stat;
+    char buffer[4096];
+    std::chrono::steady_clock::time_point prevTimePoint;
+    std::chrono::steady_clock::time_point lastRescan;
+    std::chrono::steady_clock::time_point lastFullRescan;
+    const std::chrono::seconds rescanPeriod{1};
+    const std::chrono::seconds fullRescanPeriod{10};
 };
 
 #else
@@ -192,13 +500,14 @@ public:
     std::vector<double> getCpuLoad() {return {};};
 };
 #endif
-GpuPerformanceCounter::GpuPerformanceCounter() : ov::monitor::PerformanceCounter("GPU") {}
+GpuPerformanceCounter::GpuPerformanceCounter(const std::string& sysfsRoot, const std::string& procfsRoot) :
+    ov::monitor::PerformanceCounter("GPU"), sysfsRoot{sysfsRoot}, procfsRoot{procfsRoot} {}
 GpuPerformanceCounter::~GpuPerformanceCounter() {
     delete performanceCounter; 
 }
 std::vector<double> GpuPerformanceCounter::getLoad() {
     if (!performanceCounter)
-        performanceCounter = new PerformanceCounterImpl();
+        performanceCounter = new PerformanceCounterImpl(sysfsRoot, procfsRoot);
     return performanceCounter->getGpuLoad();
 }
 }
@@ -0,0 +1,252 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/instrumentation.h"
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#elif __linux__
+#include <time.h>
+#endif
+
+namespace {
+std::mutex& registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+// a deque keeps the addresses of the existing entries
+std::deque<std::unique_ptr<ov::monitor::CounterInstrumentation>>& registry() {
+    static std::deque<std::unique_ptr<ov::monitor::CounterInstrumentation>> counters;
+    return counters;
+}
+
+// only called with a non-zero value
+unsigned countLeadingZeros(std::uint64_t value) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_clzll(value));
+#else
+    unsigned n = 0;
+    for (std::uint64_t bit = 1ULL << 63; !(value & bit); bit >>= 1)
+        ++n;
+    return n;
+#endif
+}
+}
+
+namespace ov {
+namespace monitor {
+const std::size_t LatencyHistogram::BUCKETS_NUMBER;
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds latency) {
+    std::uint64_t ns = latency.count() > 0 ? static_cast<std::uint64_t>(latency.count()) : 0;
+    std::size_t bucket = ns > 0 ? 63 - countLeadingZeros(ns) : 0;
+    buckets[bucket < BUCKETS_NUMBER ? bucket : BUCKETS_NUMBER - 1].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(ns, std::memory_order_relaxed);
+    std::uint64_t prevMax = max.load(std::memory_order_relaxed);
+    while (ns > prevMax && !max.compare_exchange_weak(prevMax, ns, std::memory_order_relaxed)) {}
+}
+
+void LatencyHistogram::reset() {
+    for (std::atomic<std::uint64_t>& bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::getCount() const {
+    return count.load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds LatencyHistogram::getSum() const {
+    return std::chrono::nanoseconds{sum.load(std::memory_order_relaxed)};
+}
+
+std::chrono::nanoseconds LatencyHistogram::getMax() const {
+    return std::chrono::nanoseconds{max.load(std::memory_order_relaxed)};
+}
+
+std::uint64_t LatencyHistogram::getBucket(std::size_t bucket) const {
+    return buckets[bucket].load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds LatencyHistogram::getPercentile(double percentile) const {
+    std::uint64_t total = 0;
+    std::uint64_t counts[BUCKETS_NUMBER];
+    for (std::size_t i = 0; i < BUCKETS_NUMBER; ++i) {
+        counts[i] = getBucket(i);
+        total += counts[i];
+    }
+    if (total == 0)
+        return std::chrono::nanoseconds{0};
+    double rank = percentile / 100 * total;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKETS_NUMBER; ++i) {
+        seen += counts[i];
+        if (seen >= rank && counts[i] > 0)
+            return i + 1 < BUCKETS_NUMBER ? std::chrono::nanoseconds{1LL << (i + 1)} : getMax();
+    }
+    return getMax();
+}
+
+CounterInstrumentation::CounterInstrumentation(const std::string& name) : name{name} {
+    reset();
+}
+
+const std::string& CounterInstrumentation::getName() const {
+    return name;
+}
+
+void CounterInstrumentation::record(Phase phase, std::chrono::nanoseconds latency) {
+    latencies[phase].record(latency);
+}
+
+void CounterInstrumentation::count(Event event) {
+    events[event].fetch_add(1, std::memory_order_relaxed);
+}
+
+void CounterInstrumentation::setThreadCpuTime(std::chrono::nanoseconds cpuTime) {
+    threadCpuTime.store(cpuTime.count(), std::memory_order_relaxed);
+}
+
+const LatencyHistogram& CounterInstrumentation::getLatency(Phase phase) const {
+    return latencies[phase];
+}
+
+std::uint64_t CounterInstrumentation::getEvents(Event event) const {
+    return events[event].load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds CounterInstrumentation::getThreadCpuTime() const {
+    return std::chrono::nanoseconds{threadCpuTime.load(std::memory_order_relaxed)};
+}
+
+void CounterInstrumentation::reset() {
+    for (LatencyHistogram& latency : latencies)
+        latency.reset();
+    for (std::atomic<std::uint64_t>& event : events)
+        event.store(0, std::memory_order_relaxed);
+    threadCpuTime.store(0, std::memory_order_relaxed);
+}
+
+std::atomic<bool> Instrumentation::enabled{false};
+
+void Instrumentation::setEnabled(bool enable) {
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+CounterInstrumentation& Instrumentation::get(const std::string& counterName) {
+    std::lock_guard<std::mutex> lock{registryMutex()};
+    for (const auto& counter : registry()) {
+        if (counter->getName() == counterName)
+            return *counter;
+    }
+    registry().emplace_back(new CounterInstrumentation(counterName));
+    return *registry().back();
+}
+
+std::vector<std::string> Instrumentation::getCounterNames() {
+    std::lock_guard<std::mutex> lock{registryMutex()};
+    std::vector<std::string> names;
+    for (const auto& counter : registry())
+        names.push_back(counter->getName());
+    return names;
+}
+
+void Instrumentation::reset() {
+    std::lock_guard<std::mutex> lock{registryMutex()};
+    for (const auto& counter : registry())
+        counter->reset();
+}
+
+std::chrono::nanoseconds Instrumentation::getThreadCpuTime() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+        return std::chrono::nanoseconds{0};
+    ULARGE_INTEGER kernelTime, userTime;
+    kernelTime.LowPart = kernel.dwLowDateTime;
+    kernelTime.HighPart = kernel.dwHighDateTime;
+    userTime.LowPart = user.dwLowDateTime;
+    userTime.HighPart = user.dwHighDateTime;
+    // 100 ns units
+    return std::chrono::nanoseconds{(kernelTime.QuadPart + userTime.QuadPart) * 100};
+#elif __linux__
+    timespec time;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+        return std::chrono::nanoseconds{0};
+    return std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+#else
+    // not implemented
+    return std::chrono::nanoseconds{0};
+#endif
+}
+
+InstrumentationPerformanceCounter::InstrumentationPerformanceCounter() :
+    ov::monitor::PerformanceCounter("Instrumentation") {}
+
+std::vector<double> InstrumentationPerformanceCounter::getLoad() {
+    auto timePoint = std::chrono::steady_clock::now();
+    std::vector<std::string> names = Instrumentation::getCounterNames();
+    if (names.size() != counters.size()) {
+        // counters are only appended, keep the baselines of the known ones
+        prevSums.resize(names.size(), std::chrono::nanoseconds{0});
+        prevEvents.resize(names.size() * CounterInstrumentation::EVENTS_NUMBER, 0);
+        events.resize(names.size() * CounterInstrumentation::EVENTS_NUMBER, 0);
+        for (std::size_t i = counters.size(); i < names.size(); ++i)
+            instrumentations.push_back(&Instrumentation::get(names[i]));
+        counters = names;
+    }
+    typedef std::chrono::duration<double, std::chrono::seconds::period> Sec;
+    double elapsed = std::chrono::duration_cast<Sec>(timePoint - prevTimePoint).count();
+    bool firstSample = prevTimePoint == std::chrono::steady_clock::time_point{};
+    prevTimePoint = timePoint;
+    std::vector<double> load(counters.size());
+    for (std::size_t i = 0; i < counters.size(); ++i) {
+        std::chrono::nanoseconds sum = instrumentations[i]->getLatency(CounterInstrumentation::TOTAL).getSum();
+        // reset() restarts the sums
+        std::chrono::nanoseconds delta = sum >= prevSums[i] ? sum - prevSums[i] : sum;
+        prevSums[i] = sum;
+        load[i] = elapsed > 0 ? std::chrono::duration_cast<Sec>(delta).count() / elapsed : 0;
+        for (int event = 0; event < CounterInstrumentation::EVENTS_NUMBER; ++event) {
+            std::size_t j = i * CounterInstrumentation::EVENTS_NUMBER + event;
+            std::uint64_t total = instrumentations[i]->getEvents(static_cast<CounterInstrumentation::Event>(event));
+            events[j] = total >= prevEvents[j] ? total - prevEvents[j] : total;
+            prevEvents[j] = total;
+        }
+    }
+    if (firstSample)
+        return {};
+    return load;
+}
+
+const std::vector<std::string>& InstrumentationPerformanceCounter::getCounters() const {
+    return counters;
+}
+
+std::uint64_t InstrumentationPerformanceCounter::getEvents(std::size_t counter,
+                                                           CounterInstrumentation::Event event) const {
+    return counter < counters.size() ? events[counter * CounterInstrumentation::EVENTS_NUMBER + event] : 0;
+}
+
+const LatencyHistogram& InstrumentationPerformanceCounter::getLatency(std::size_t counter,
+                                                                      CounterInstrumentation::Phase phase) const {
+    return instrumentations.at(counter)->getLatency(phase);
+}
+
+std::chrono::nanoseconds InstrumentationPerformanceCounter::getThreadCpuTime(std::size_t counter) const {
+    return counter < counters.size() ? instrumentations[counter]->getThreadCpuTime() : std::chrono::nanoseconds{0};
+}
+}
+}
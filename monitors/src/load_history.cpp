@@ -0,0 +1,116 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/load_history.h"
+
+#include <algorithm>
+
+namespace ov {
+namespace monitor {
+LoadHistory::LoadHistory(std::size_t capacity, std::size_t nCores) :
+    historyCapacity{capacity > 0 ? capacity : 1},
+    nCores{nCores},
+    samples(historyCapacity * nCores, 0.0),
+    sums(nCores, 0.0) {}
+
+void LoadHistory::reset(std::size_t capacity, std::size_t cores) {
+    historyCapacity = capacity > 0 ? capacity : 1;
+    nCores = cores;
+    head = 0;
+    count = 0;
+    samples.assign(historyCapacity * nCores, 0.0);
+    sums.assign(nCores, 0.0);
+}
+
+void LoadHistory::setCapacity(std::size_t capacity) {
+    capacity = capacity > 0 ? capacity : 1;
+    if (capacity == historyCapacity)
+        return;
+    std::size_t newCount = std::min(count, capacity);
+    std::vector<double> newSamples(capacity * nCores, 0.0);
+    for (std::size_t core = 0; core < nCores; ++core) {
+        for (std::size_t i = 0; i < newCount; ++i) {
+            newSamples[core * capacity + i] = at(count - newCount + i, core);
+        }
+    }
+    samples.swap(newSamples);
+    historyCapacity = capacity;
+    head = 0;
+    count = newCount;
+    recomputeSums();
+}
+
+void LoadHistory::clear() {
+    head = 0;
+    count = 0;
+    std::fill(sums.begin(), sums.end(), 0.0);
+}
+
+void LoadHistory::push(const double* load) {
+    std::size_t slot = (head + count) % historyCapacity;
+    if (count == historyCapacity) {
+        for (std::size_t core = 0; core < nCores; ++core) {
+            double& value = samples[core * historyCapacity + slot];
+            sums[core] += load[core] - value;
+            value = load[core];
+        }
+        head = (head + 1) % historyCapacity;
+        // running sums accumulate rounding errors, recompute them once per wrap: still O(cores) amortized
+        if (head == 0)
+            recomputeSums();
+    } else {
+        for (std::size_t core = 0; core < nCores; ++core) {
+            samples[core * historyCapacity + slot] = load[core];
+            sums[core] += load[core];
+        }
+        ++count;
+    }
+}
+
+std::size_t LoadHistory::size() const {
+    return count;
+}
+
+std::size_t LoadHistory::capacity() const {
+    return historyCapacity;
+}
+
+std::size_t LoadHistory::getNumberOfCores() const {
+    return nCores;
+}
+
+bool LoadHistory::full() const {
+    return count == historyCapacity;
+}
+
+double LoadHistory::at(std::size_t sample, std::size_t core) const {
+    return samples[core * historyCapacity + (head + sample) % historyCapacity];
+}
+
+double LoadHistory::getSum(std::size_t core) const {
+    return sums[core];
+}
+
+double LoadHistory::getMean(std::size_t core) const {
+    return count ? sums[core] / count : 0;
+}
+
+const double* LoadHistory::getCoreSamples(std::size_t core) const {
+    return samples.data() + core * historyCapacity;
+}
+
+std::size_t LoadHistory::getHead() const {
+    return head;
+}
+
+void LoadHistory::recomputeSums() {
+    for (std::size_t core = 0; core < nCores; ++core) {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < count; ++i)
+            sum += at(i, core);
+        sums[core] = sum;
+    }
+}
+}
+}
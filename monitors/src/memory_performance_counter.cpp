@@ -0,0 +1,200 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include "monitors/performance_counter.h"
+#include "monitors/memory_performance_counter.h"
+#ifdef __linux__
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <dirent.h>
+#include "proc_file.h"
+
+namespace {
+const char* const memoryKeys[ov::monitor::MemoryPerformanceCounter::MEMORY_FIELDS_NUMBER] = {
+    "MemTotal", "MemFree", "MemAvailable", "Buffers", "Cached", "AnonPages", "Shmem", "Slab", "Dirty",
+    "SwapTotal", "SwapFree"};
+// node meminfo calls the page cache FilePages
+const char* const nodeMemoryKeys[ov::monitor::MemoryPerformanceCounter::MEMORY_FIELDS_NUMBER] = {
+    "MemTotal", "MemFree", "MemAvailable", "Buffers", "FilePages", "AnonPages", "Shmem", "Slab", "Dirty",
+    "SwapTotal", "SwapFree"};
+const char* const vmstatKeys[ov::monitor::MemoryPerformanceCounter::VMSTAT_FIELDS_NUMBER] = {
+    "pgfault", "pgmajfault", "pgpgin", "pgpgout", "pswpin", "pswpout",
+    "numa_hit", "numa_miss", "numa_foreign", "numa_local", "numa_other"};
+
+bool keyEquals(const char* key, std::size_t length, const char* expected) {
+    return std::strncmp(key, expected, length) == 0 && expected[length] == 0;
+}
+
+// Lines are "Key: value [kB]" (meminfo, optionally prefixed with "Node N ") or "key value" (vmstat).
+void parseKeyValues(const char* data, const char* const* keys, std::size_t keysNumber, unsigned long long* values) {
+    std::fill(values, values + keysNumber, 0);
+    for (const char* line = data; *line; line = ov::monitor::nextLine(line)) {
+        if (std::strncmp(line, "Node ", 5) == 0) {
+            line += 5;
+            while (*line >= '0' && *line <= '9')
+                ++line;
+            while (*line == ' ')
+                ++line;
+        }
+        const char* keyEnd = line;
+        while (*keyEnd && *keyEnd != ':' && *keyEnd != ' ' && *keyEnd != '\n')
+            ++keyEnd;
+        std::size_t length = keyEnd - line;
+        for (std::size_t i = 0; i < keysNumber; ++i) {
+            if (keyEquals(line, length, keys[i])) {
+                const char* p = ov::monitor::parseUnsigned(*keyEnd == ':' ? keyEnd + 1 : keyEnd, values[i]);
+                if (p[0] == ' ' && p[1] == 'k' && p[2] == 'B')
+                    values[i] *= 1024;
+                break;
+            }
+        }
+    }
+}
+}
+
+namespace ov {
+namespace monitor {
+class MemoryPerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl(const std::string& procfsRoot, const std::string& sysfsRoot) :
+        meminfo{procfsRoot + "/meminfo"}, vmstat{procfsRoot + "/vmstat", 16384} {
+        std::vector<int> nodeIds;
+        std::string nodesPath = sysfsRoot + "/devices/system/node";
+        if (DIR* dir = opendir(nodesPath.c_str())) {
+            while (dirent* entry = readdir(dir)) {
+                if (std::strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9')
+                    nodeIds.push_back(std::atoi(entry->d_name + 4));
+            }
+            closedir(dir);
+        }
+        std::sort(nodeIds.begin(), nodeIds.end());
+        for (int node : nodeIds)
+            nodeMeminfo.emplace_back(nodesPath + "/node" + std::to_string(node) + "/meminfo");
+        memory.resize((nodeMeminfo.size() + 1) * MEMORY_FIELDS_NUMBER);
+        readVmstat(prevCounters);
+        prevTimePoint = std::chrono::steady_clock::now();
+    }
+
+    std::vector<double> getMemoryLoad() {
+        std::size_t size;
+        parseKeyValues(meminfo.read(size), memoryKeys, MEMORY_FIELDS_NUMBER, memory.data());
+        for (std::size_t node = 0; node < nodeMeminfo.size(); ++node) {
+            unsigned long long* values = memory.data() + (node + 1) * MEMORY_FIELDS_NUMBER;
+            parseKeyValues(nodeMeminfo[node].read(size), nodeMemoryKeys, MEMORY_FIELDS_NUMBER, values);
+        }
+
+        readVmstat(counters);
+        auto timePoint = std::chrono::steady_clock::now();
+        typedef std::chrono::duration<double, std::chrono::seconds::period> Sec;
+        double elapsed = std::chrono::duration_cast<Sec>(timePoint - prevTimePoint).count();
+        for (std::size_t i = 0; i < VMSTAT_FIELDS_NUMBER; ++i) {
+            rates[i] = elapsed > 0 && counters[i] >= prevCounters[i] ? (counters[i] - prevCounters[i]) / elapsed : 0;
+        }
+        std::swap(counters, prevCounters);
+        prevTimePoint = timePoint;
+
+        std::vector<double> memoryLoad(nodeMeminfo.size() + 1);
+        const unsigned long long* system = memory.data();
+        // MemAvailable accounts for reclaimable caches; it is missing on very old kernels and in node meminfo
+        unsigned long long available = system[MEM_AVAILABLE] ? system[MEM_AVAILABLE] : estimateAvailable(system);
+        memoryLoad[0] = system[MEM_TOTAL] ? 1.0 - static_cast<double>(available) / system[MEM_TOTAL] : 0;
+        for (std::size_t node = 0; node < nodeMeminfo.size(); ++node) {
+            const unsigned long long* values = memory.data() + (node + 1) * MEMORY_FIELDS_NUMBER;
+            available = estimateAvailable(values);
+            memoryLoad[node + 1] = values[MEM_TOTAL] ? 1.0 - static_cast<double>(available) / values[MEM_TOTAL] : 0;
+        }
+        return memoryLoad;
+    }
+
+    std::size_t getNumberOfNodes() const {
+        return nodeMeminfo.size();
+    }
+
+    unsigned long long getValue(MemoryField field, int node) const {
+        if (node < -1 || node >= static_cast<int>(nodeMeminfo.size()))
+            throw std::out_of_range("The NUMA node doesn't exist");
+        return memory[(node + 1) * MEMORY_FIELDS_NUMBER + field];
+    }
+
+    unsigned long long getCounter(VmstatField field) const {
+        // the last sample was swapped into prevCounters
+        return prevCounters[field];
+    }
+
+    double getRate(VmstatField field) const {
+        return rates[field];
+    }
+
+private:
+    // Free memory and the page cache, Buffers included, without Shmem which can't be dropped: close to
+    // MemAvailable, so that the system and the nodes are measured alike.
+    static unsigned long long estimateAvailable(const unsigned long long* values) {
+        unsigned long long cache = values[BUFFERS] + values[CACHED];
+        return values[MEM_FREE] + (cache > values[SHMEM] ? cache - values[SHMEM] : 0);
+    }
+
+    void readVmstat(unsigned long long* values) {
+        std::size_t size;
+        parseKeyValues(vmstat.read(size), vmstatKeys, VMSTAT_FIELDS_NUMBER, values);
+    }
+
+    ProcFile meminfo;
+    ProcFile vmstat;
+    std::vector<ProcFile> nodeMeminfo;
+    std::vector<unsigned long long> memory;
+    unsigned long long counters[VMSTAT_FIELDS_NUMBER] = {};
+    unsigned long long prevCounters[VMSTAT_FIELDS_NUMBER] = {};
+    double rates[VMSTAT_FIELDS_NUMBER] = {};
+    std::chrono::steady_clock::time_point prevTimePoint;
+};
+
+#else
+// not implemented
+namespace ov {
+namespace monitor {
+class MemoryPerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl(const std::string&, const std::string&) {}
+    std::vector<double> getMemoryLoad() {return {};}
+    std::size_t getNumberOfNodes() const {return 0;}
+    unsigned long long getValue(MemoryField, int node) const {
+        if (node != -1)
+            throw std::out_of_range("The NUMA node doesn't exist");
+        return 0;
+    }
+    unsigned long long getCounter(VmstatField) const {return 0;}
+    double getRate(VmstatField) const {return 0;}
+};
+#endif
+MemoryPerformanceCounter::MemoryPerformanceCounter(const std::string& procfsRoot, const std::string& sysfsRoot) :
+    ov::monitor::PerformanceCounter("Memory"), procfsRoot{procfsRoot}, sysfsRoot{sysfsRoot} {}
+MemoryPerformanceCounter::~MemoryPerformanceCounter() {
+    delete performanceCounter;
+}
+MemoryPerformanceCounter::PerformanceCounterImpl& MemoryPerformanceCounter::impl() {
+    if (!performanceCounter)
+        performanceCounter = new PerformanceCounterImpl(procfsRoot, sysfsRoot);
+    return *performanceCounter;
+}
+std::vector<double> MemoryPerformanceCounter::getLoad() {
+    return impl().getMemoryLoad();
+}
+std::size_t MemoryPerformanceCounter::getNumberOfNodes() {
+    return impl().getNumberOfNodes();
+}
+unsigned long long MemoryPerformanceCounter::getValue(MemoryField field, int node) {
+    return impl().getValue(field, node);
+}
+unsigned long long MemoryPerformanceCounter::getCounter(VmstatField field) {
+    return impl().getCounter(field);
+}
+double MemoryPerformanceCounter::getRate(VmstatField field) {
+    return impl().getRate(field);
+}
+}
+}
@@ -0,0 +1,294 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/metrics_exporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#ifndef _WIN32
+#include <cerrno>
+#include <system_error>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+const std::size_t maxConnections = 64;
+const std::chrono::seconds requestTimeout{1};
+const std::chrono::seconds responseTimeout{1};
+const char contentType[] = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+void appendNumber(std::string& out, double value) {
+    if (std::isnan(value)) {
+        out += "NaN";
+    } else if (std::isinf(value)) {
+        out += value > 0 ? "+Inf" : "-Inf";
+    } else {
+        char number[32];
+        int size = snprintf(number, sizeof(number), "%.6g", value);
+        out.append(number, size);
+    }
+}
+
+void appendResponse(std::string& out, const char* status, const std::string& body) {
+    char header[256];
+    int size = snprintf(header, sizeof(header),
+                        "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n",
+                        status, contentType, body.size());
+    out.append(header, size);
+    out += body;
+}
+}
+
+namespace ov {
+namespace monitor {
+MetricsExporter::MetricsExporter(unsigned short port, const std::string& address) :
+    address{address}, port{port}, response{std::make_shared<std::string>()} {
+    render(MonitorHub::Batch{}, *response);
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+void MetricsExporter::addMetric(const std::string& name, const std::string& help, const std::string& label) {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (running) {
+        throw std::logic_error("Metrics can't be added to a running MetricsExporter");
+    }
+    metrics.push_back({name, help, label});
+}
+
+void MetricsExporter::publish(const MonitorHub::Batch& batch) {
+    std::shared_ptr<std::string> next;
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        // a scrape still sending the spare buffer keeps it alive, it is released with the last reference
+        if (spare && spare.use_count() == 1)
+            next.swap(spare);
+    }
+    if (!next)
+        next = std::make_shared<std::string>();
+    render(batch, *next);
+    std::lock_guard<std::mutex> lock{mutex};
+    spare.swap(response);
+    response.swap(next);
+}
+
+void MetricsExporter::render(const MonitorHub::Batch& batch, std::string& out) {
+    // the buffers keep their capacity, so rendering stops allocating after the first batches
+    std::string& text = body;
+    text.clear();
+    text += "# TYPE ov_monitor_ticks counter\n# HELP ov_monitor_ticks Ticks of the monitor.\nov_monitor_ticks_total ";
+    appendNumber(text, static_cast<double>(batch.tick));
+    text += '\n';
+    for (std::size_t i = 0; i < metrics.size(); ++i) {
+        const Metric& metric = metrics[i];
+        text += "# TYPE ";
+        text += metric.name;
+        text += " gauge\n# HELP ";
+        text += metric.name;
+        text += ' ';
+        text += metric.help;
+        text += '\n';
+        if (i >= batch.samples.size() || batch.samples[i].status != MonitorHub::Sample::OK)
+            continue;
+        const std::vector<double>& load = batch.samples[i].load;
+        char index[24];
+        for (std::size_t j = 0; j < load.size(); ++j) {
+            text += metric.name;
+            text += '{';
+            text += metric.label;
+            text += "=\"";
+            text.append(index, snprintf(index, sizeof(index), "%zu", j));
+            text += "\"} ";
+            appendNumber(text, load[j]);
+            text += '\n';
+        }
+    }
+    text += "# EOF\n";
+    out.clear();
+    appendResponse(out, "200 OK", text);
+}
+
+bool MetricsExporter::isRunning() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return running;
+}
+
+unsigned short MetricsExporter::getPort() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return port;
+}
+
+#ifdef _WIN32
+// not implemented
+void MetricsExporter::start() {
+    throw std::runtime_error("MetricsExporter is not implemented on Windows");
+}
+
+void MetricsExporter::stop() {}
+
+void MetricsExporter::serve() {}
+
+bool MetricsExporter::receiveRequest(Connection&) {
+    return false;
+}
+
+bool MetricsExporter::sendResponse(Connection&) {
+    return false;
+}
+#else
+void MetricsExporter::start() {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (running)
+        return;
+    sockaddr_in socketAddress = {};
+    socketAddress.sin_family = AF_INET;
+    socketAddress.sin_port = htons(port);
+    if (inet_pton(AF_INET, address.c_str(), &socketAddress.sin_addr) != 1) {
+        throw std::invalid_argument("Invalid IPv4 address " + address);
+    }
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        throw std::system_error(errno, std::system_category(), "socket() failed");
+    }
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    socklen_t length = sizeof(socketAddress);
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0
+        || listen(listenFd, 64) != 0
+        || getsockname(listenFd, reinterpret_cast<sockaddr*>(&socketAddress), &length) != 0
+        || pipe2(wakeUpFds, O_CLOEXEC) != 0) {
+        int error = errno;
+        close(listenFd);
+        listenFd = -1;
+        throw std::system_error(error, std::system_category(), "Can't listen on " + address);
+    }
+    port = ntohs(socketAddress.sin_port);
+    running = true;
+    thread = std::thread(&MetricsExporter::serve, this);
+}
+
+void MetricsExporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (!running)
+            return;
+    }
+    char wakeUp = 0;
+    while (write(wakeUpFds[1], &wakeUp, 1) < 0 && errno == EINTR) {}
+    thread.join();
+    std::lock_guard<std::mutex> lock{mutex};
+    close(listenFd);
+    close(wakeUpFds[0]);
+    close(wakeUpFds[1]);
+    listenFd = wakeUpFds[0] = wakeUpFds[1] = -1;
+    running = false;
+}
+
+void MetricsExporter::serve() {
+    std::vector<Connection> connections;
+    std::vector<pollfd> fds;
+    while (true) {
+        fds.clear();
+        fds.push_back({wakeUpFds[0], POLLIN, 0});
+        // a full table leaves new connections in the listen backlog
+        fds.push_back({listenFd, static_cast<short>(connections.size() < maxConnections ? POLLIN : 0), 0});
+        auto now = std::chrono::steady_clock::now();
+        int timeout = -1;
+        for (const Connection& connection : connections) {
+            fds.push_back({connection.fd, static_cast<short>(connection.response ? POLLOUT : POLLIN), 0});
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(connection.deadline - now).count() + 1;
+            if (timeout < 0 || left < timeout)
+                timeout = left > 0 ? static_cast<int>(left) : 0;
+        }
+        if (poll(fds.data(), fds.size(), timeout) < 0 && errno != EINTR)
+            break;
+        if (fds[0].revents)
+            break;
+        now = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < connections.size(); ++i) {
+            Connection& connection = connections[i];
+            bool open = true;
+            if (fds[i + 2].revents)
+                open = connection.response ? sendResponse(connection) : receiveRequest(connection);
+            if (open && now >= connection.deadline)
+                open = false;
+            if (!open) {
+                close(connection.fd);
+                connection.fd = -1;
+            }
+        }
+        connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                         [](const Connection& connection) { return connection.fd < 0; }),
+                          connections.end());
+        while ((fds[1].revents & POLLIN) && connections.size() < maxConnections) {
+            int fd = accept4(listenFd, NULL, NULL, SOCK_CLOEXEC | SOCK_NONBLOCK);
+            if (fd < 0)
+                break;
+            connections.emplace_back();
+            connections.back().fd = fd;
+            connections.back().deadline = now + requestTimeout;
+        }
+    }
+    for (const Connection& connection : connections)
+        close(connection.fd);
+}
+
+// Connections are closed after the response. A client is given a second to send its request and a second to
+// read the response, a scrape only sends a rendered buffer.
+bool MetricsExporter::receiveRequest(Connection& connection) {
+    char* request = connection.request;
+    std::size_t& size = connection.received;
+    while (size < sizeof(connection.request) - 1 && !memmem(request, size, "\r\n\r\n", 4)) {
+        ssize_t received = recv(connection.fd, request + size, sizeof(connection.request) - 1 - size, 0);
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received < 0)
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        if (received == 0)
+            return false;
+        size += static_cast<std::size_t>(received);
+    }
+    request[size] = 0;
+
+    if (strncmp(request, "GET /metrics ", 13) == 0 || strncmp(request, "GET / ", 6) == 0) {
+        std::lock_guard<std::mutex> lock{mutex};
+        connection.response = response;
+    } else {
+        connection.response = std::make_shared<std::string>();
+        appendResponse(*connection.response,
+                       strncmp(request, "GET ", 4) == 0 ? "404 Not Found" : "405 Method Not Allowed", "");
+    }
+    connection.deadline = std::chrono::steady_clock::now() + responseTimeout;
+    return sendResponse(connection);
+}
+
+bool MetricsExporter::sendResponse(Connection& connection) {
+    const std::string& out = *connection.response;
+    while (connection.sent < out.size()) {
+        ssize_t written = send(connection.fd, out.data() + connection.sent, out.size() - connection.sent,
+                               MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written < 0)
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        connection.sent += static_cast<std::size_t>(written);
+    }
+    // let the client read the response before the connection is closed
+    shutdown(connection.fd, SHUT_WR);
+    return false;
+}
+#endif
+}
+}
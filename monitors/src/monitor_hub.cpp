@@ -0,0 +1,204 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/monitor_hub.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ov {
+namespace monitor {
+MonitorHub::MonitorHub(std::chrono::milliseconds period, std::size_t workersNumber) :
+    period{std::max(period, std::chrono::milliseconds{1})}, workersNumber{std::max<std::size_t>(workersNumber, 1)} {
+    queues.emplace_back(new JobQueue);
+}
+
+MonitorHub::~MonitorHub() {
+    stop();
+}
+
+std::size_t MonitorHub::addCounter(const std::shared_ptr<ov::monitor::PerformanceCounter>& counter, bool dedicatedThread) {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (running) {
+        throw std::logic_error("Counters can't be added to a running MonitorHub");
+    }
+    counters.push_back(counter);
+    instrumentations.push_back(&Instrumentation::get(counter->getCounterName()));
+    if (dedicatedThread) {
+        queues.emplace_back(new JobQueue);
+        counterQueues.push_back(queues.size() - 1);
+    } else {
+        counterQueues.push_back(0);
+    }
+    return counters.size() - 1;
+}
+
+void MonitorHub::setBatchCallback(const BatchCallback& batchCallback) {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (running) {
+        throw std::logic_error("The callback of a running MonitorHub can't be changed");
+    }
+    callback = batchCallback;
+}
+
+void MonitorHub::start() {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (running)
+        return;
+    running = true;
+    stopRequested = false;
+    inFlight.assign(counters.size(), false);
+    pendingPublished = true;
+    for (auto& queue : queues) {
+        queue->stopRequested = false;
+        queue->jobs.clear();
+    }
+    for (std::size_t i = 0; i < workersNumber; ++i)
+        threads.emplace_back(&MonitorHub::workerLoop, this, std::ref(*queues[0]));
+    for (std::size_t i = 1; i < queues.size(); ++i)
+        threads.emplace_back(&MonitorHub::workerLoop, this, std::ref(*queues[i]));
+    threads.emplace_back(&MonitorHub::timerLoop, this);
+}
+
+void MonitorHub::stop() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (!running)
+            return;
+        stopRequested = true;
+    }
+    timerWakeUp.notify_all();
+    for (auto& queue : queues) {
+        std::lock_guard<std::mutex> lock{queue->mutex};
+        queue->stopRequested = true;
+        queue->wakeUp.notify_all();
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    threads.clear();
+    std::lock_guard<std::mutex> lock{mutex};
+    running = false;
+}
+
+bool MonitorHub::isRunning() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return running;
+}
+
+MonitorHub::Batch MonitorHub::getLastBatch() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return lastBatch;
+}
+
+std::chrono::milliseconds MonitorHub::getPeriod() const {
+    return period;
+}
+
+void MonitorHub::timerLoop() {
+    std::unique_lock<std::mutex> lock{mutex};
+    auto nextTick = std::chrono::steady_clock::now();
+    std::uint64_t tick = 0;
+    while (!stopRequested) {
+        if (!pendingPublished)
+            publish(lock);
+        if (stopRequested)
+            break;
+
+        pending.tick = ++tick;
+        pending.timestamp = std::chrono::steady_clock::now();
+        pending.samples.assign(counters.size(), Sample{});
+        pendingPublished = false;
+        pendingExpected = 0;
+        pendingCompleted = 0;
+        for (std::size_t i = 0; i < counters.size(); ++i) {
+            if (inFlight[i]) {
+                pending.samples[i].status = Sample::SKIPPED;
+                if (Instrumentation::isEnabled())
+                    instrumentations[i]->count(CounterInstrumentation::SKIPPED);
+                continue;
+            }
+            inFlight[i] = true;
+            ++pendingExpected;
+            JobQueue& queue = *queues[counterQueues[i]];
+            std::lock_guard<std::mutex> queueLock{queue.mutex};
+            queue.jobs.push_back(Job{i, tick});
+            queue.wakeUp.notify_one();
+        }
+        if (pendingExpected == 0)
+            publish(lock);
+
+        nextTick += period;
+        auto now = std::chrono::steady_clock::now();
+        if (nextTick < now)
+            nextTick = now + period;
+        timerWakeUp.wait_until(lock, nextTick, [this] { return stopRequested; });
+    }
+}
+
+void MonitorHub::workerLoop(JobQueue& queue) {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock{queue.mutex};
+            queue.wakeUp.wait(lock, [&queue] { return queue.stopRequested || !queue.jobs.empty(); });
+            if (queue.stopRequested)
+                return;
+            job = queue.jobs.front();
+            queue.jobs.pop_front();
+        }
+        sample(job);
+    }
+}
+
+void MonitorHub::sample(const Job& job) {
+    Sample sample;
+    CounterInstrumentation& instrumentation = *instrumentations[job.counter];
+    {
+        PhaseTimer timer{instrumentation, CounterInstrumentation::TOTAL};
+        try {
+            sample.load = counters[job.counter]->getLoad();
+            sample.status = sample.load.empty() ? Sample::NO_DATA : Sample::OK;
+        } catch (...) {
+            sample.status = Sample::FAILED;
+        }
+    }
+    if (Instrumentation::isEnabled()) {
+        instrumentation.count(sample.status == Sample::OK ? CounterInstrumentation::SAMPLES
+            : sample.status == Sample::NO_DATA ? CounterInstrumentation::NO_DATA : CounterInstrumentation::ERRORS);
+        instrumentation.setThreadCpuTime(Instrumentation::getThreadCpuTime());
+    }
+    std::unique_lock<std::mutex> lock{mutex};
+    inFlight[job.counter] = false;
+    // results for an already published batch are dropped
+    if (pendingPublished || pending.tick != job.tick)
+        return;
+    pending.samples[job.counter] = std::move(sample);
+    if (++pendingCompleted == pendingExpected)
+        publish(lock);
+}
+
+void MonitorHub::publish(std::unique_lock<std::mutex>& lock) {
+    pendingPublished = true;
+    lastBatch = pending;
+    if (!callback)
+        return;
+    Batch batch = lastBatch;
+    std::uint64_t ticket = publishedNumber++;
+    lock.unlock();
+    {
+        // keep the callbacks in the publication order without holding the hub lock, so they may call getLastBatch()
+        std::unique_lock<std::mutex> callbackLock{callbackMutex};
+        callbackTurn.wait(callbackLock, [this, ticket] { return calledNumber == ticket; });
+        try {
+            callback(batch);
+        } catch (...) {
+            // a throwing callback must not stall the following batches
+        }
+        ++calledNumber;
+    }
+    callbackTurn.notify_all();
+    lock.lock();
+}
+}
+}
@@ -0,0 +1,107 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "proc_file.h"
+
+namespace ov {
+namespace monitor {
+// The counters of a procfs table with a named row per line, like /proc/diskstats and /proc/net/dev. Lines are
+// matched to the known rows by position, so the rows (and the filtering) are only rebuilt when one appears or
+// disappears. Rows the filter excludes are kept as well, so that the positions still match.
+template <std::size_t FieldsNumber>
+class NamedRows {
+public:
+    struct Row {
+        std::string name;
+        bool included;
+        std::size_t index;  // among the included rows
+        unsigned long long values[FieldsNumber];
+        unsigned long long prevValues[FieldsNumber];
+    };
+
+    // Reads the values of every row, the previous ones are kept for the deltas. New rows start from their
+    // current values, so the first read is the baseline.
+    // parseName: const char*(const char* line, const char*& name, const char*& nameEnd) returns where the values
+    // of the line start, or NULL for lines without a row like headers.
+    // isIncluded: bool(const std::string& name)
+    template <typename ParseName, typename IsIncluded>
+    void read(const char* data, ParseName parseName, IsIncluded isIncluded) {
+        for (Row& row : rows)
+            std::copy(row.values, row.values + FieldsNumber, row.prevValues);
+        if (!parse(data, parseName)) {
+            rebuild(data, parseName, isIncluded);
+            parse(data, parseName);
+        }
+    }
+
+    const std::vector<Row>& getRows() const {
+        return rows;
+    }
+
+    // The included rows in the order of the table.
+    const std::vector<std::string>& getNames() const {
+        return names;
+    }
+
+private:
+    // Returns false if the rows differ from the known ones.
+    template <typename ParseName>
+    bool parse(const char* data, ParseName& parseName) {
+        std::size_t line = 0;
+        const char* name;
+        const char* nameEnd;
+        for (const char* p = data; *p; p = nextLine(p)) {
+            const char* values = parseName(p, name, nameEnd);
+            if (!values)
+                continue;
+            if (line >= rows.size() || rows[line].name.compare(0, std::string::npos, name, nameEnd - name) != 0)
+                return false;
+            parseValues(values, rows[line++].values);
+        }
+        return line == rows.size();
+    }
+
+    template <typename ParseName, typename IsIncluded>
+    void rebuild(const char* data, ParseName& parseName, IsIncluded& isIncluded) {
+        std::vector<Row> known;
+        known.swap(rows);
+        names.clear();
+        const char* name;
+        const char* nameEnd;
+        for (const char* p = data; *p; p = nextLine(p)) {
+            const char* values = parseName(p, name, nameEnd);
+            if (!values)
+                continue;
+            Row row;
+            row.name.assign(name, nameEnd);
+            row.included = isIncluded(row.name);
+            row.index = row.included ? names.size() : 0;
+            if (row.included)
+                names.push_back(row.name);
+            // keep the counters of known rows
+            auto old = std::find_if(known.begin(), known.end(), [&row](const Row& r) { return r.name == row.name; });
+            std::fill(row.values, row.values + FieldsNumber, 0);
+            if (old != known.end())
+                std::copy(old->prevValues, old->prevValues + FieldsNumber, row.prevValues);
+            else
+                parseValues(values, row.prevValues);
+            rows.push_back(row);
+        }
+    }
+
+    static void parseValues(const char* p, unsigned long long* values) {
+        for (std::size_t field = 0; field < FieldsNumber; ++field)
+            p = parseUnsigned(p, values[field]);
+    }
+
+    std::vector<Row> rows;
+    std::vector<std::string> names;
+};
+}
+}
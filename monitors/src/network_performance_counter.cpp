@@ -0,0 +1,201 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <algorithm>
+#include "monitors/performance_counter.h"
+#include "monitors/network_performance_counter.h"
+#ifdef __linux__
+#include <chrono>
+#include <cstring>
+#include "monitors/instrumentation.h"
+#include "named_rows.h"
+#include "proc_file.h"
+
+namespace {
+// /proc/net/dev columns after "<interface>:"
+enum NetDevField {
+    NET_RX_BYTES = 0,
+    NET_RX_PACKETS,
+    NET_RX_ERRS,
+    NET_RX_DROP,
+    NET_RX_FIFO,
+    NET_RX_FRAME,
+    NET_RX_COMPRESSED,
+    NET_RX_MULTICAST,
+    NET_TX_BYTES,
+    NET_TX_PACKETS,
+    NET_TX_ERRS,
+    NET_TX_DROP,
+    NET_DEV_FIELDS_NUMBER = 16
+};
+
+const int metricFields[ov::monitor::NetworkPerformanceCounter::METRICS_NUMBER] = {
+    NET_RX_BYTES, NET_RX_PACKETS, NET_RX_ERRS, NET_RX_DROP, NET_TX_BYTES, NET_TX_PACKETS, NET_TX_ERRS, NET_TX_DROP};
+
+// rates over shorter intervals would only show single packet bursts
+const std::chrono::milliseconds minInterval{5};
+
+// "  eth0: 1234 5 0 0 ..." The two header lines have no row.
+const char* parseName(const char* line, const char*& name, const char*& nameEnd) {
+    while (*line == ' ')
+        ++line;
+    const char* colon = line;
+    while (*colon && *colon != ':' && *colon != '\n' && *colon != '|')
+        ++colon;
+    if (*colon != ':')
+        return NULL;
+    name = line;
+    nameEnd = colon;
+    return colon + 1;
+}
+}
+
+namespace ov {
+namespace monitor {
+class NetworkPerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl(const std::vector<std::string>& interfaces, const std::string& procfsRoot) :
+        selected(interfaces), netDev{procfsRoot + "/net/dev"} {
+        readNetDev();
+        prevTimePoint = std::chrono::steady_clock::now();
+    }
+
+    std::vector<double> getNetworkLoad() {
+        if (!update())
+            return {};
+        return networkLoad;
+    }
+
+    SampleInfo sample(double* load, std::size_t capacity) {
+        SampleInfo info;
+        if (!unsent) {
+            // checked against the known rows before reading, so the sample isn't lost
+            if (rows.getNames().size() > capacity) {
+                info.status = SampleInfo::BUFFER_TOO_SMALL;
+                info.size = rows.getNames().size();
+                return info;
+            }
+            if (!update())
+                return info;
+        }
+        info.timestamp = prevTimePoint;
+        info.interval = interval;
+        info.size = networkLoad.size();
+        // rows appeared while reading: the sample is kept for the retry with a bigger buffer
+        unsent = networkLoad.size() > capacity;
+        if (unsent) {
+            info.status = SampleInfo::BUFFER_TOO_SMALL;
+            return info;
+        }
+        std::copy(networkLoad.begin(), networkLoad.end(), load);
+        info.status = SampleInfo::OK;
+        return info;
+    }
+
+    const std::vector<std::string>& getInterfaces() const {
+        return rows.getNames();
+    }
+
+    double getRate(Metric metric, std::size_t interface) const {
+        return interface < rows.getNames().size() && !rates.empty() ? rates[interface * METRICS_NUMBER + metric] : 0;
+    }
+
+private:
+    typedef NamedRows<NET_DEV_FIELDS_NUMBER> InterfaceRows;
+
+    // Sets the time the new rates are computed over. Returns false without reading anything if the
+    // previous sample, or the baseline the constructor takes, is less than minInterval ago.
+    bool update() {
+        if (std::chrono::steady_clock::now() - prevTimePoint < minInterval)
+            return false;
+        unsent = false;
+        readNetDev();
+        auto timePoint = std::chrono::steady_clock::now();
+        interval = timePoint - prevTimePoint;
+        typedef std::chrono::duration<double, std::chrono::seconds::period> Sec;
+        double elapsed = std::chrono::duration_cast<Sec>(interval).count();
+        prevTimePoint = timePoint;
+
+        PhaseTimer timer{instrumentation, CounterInstrumentation::COMPUTE};
+        rates.assign(rows.getNames().size() * METRICS_NUMBER, 0.0);
+        networkLoad.assign(rows.getNames().size(), 0.0);
+        for (const InterfaceRows::Row& row : rows.getRows()) {
+            if (!row.included || elapsed <= 0)
+                continue;
+            double* rate = rates.data() + row.index * METRICS_NUMBER;
+            for (int metric = 0; metric < METRICS_NUMBER; ++metric) {
+                int field = metricFields[metric];
+                // counters restart when a driver is reloaded
+                rate[metric] = row.values[field] >= row.prevValues[field]
+                    ? (row.values[field] - row.prevValues[field]) / elapsed : 0;
+            }
+            networkLoad[row.index] = rate[RX_BYTES] + rate[TX_BYTES];
+        }
+        return true;
+    }
+
+    void readNetDev() {
+        std::size_t size;
+        const char* data;
+        {
+            PhaseTimer timer{instrumentation, CounterInstrumentation::READ};
+            data = netDev.read(size);
+        }
+        PhaseTimer timer{instrumentation, CounterInstrumentation::PARSE};
+        rows.read(data, parseName, [this](const std::string& name) {
+            return selected.empty() ? name != "lo" : std::find(selected.begin(), selected.end(), name) != selected.end();
+        });
+    }
+
+    std::vector<std::string> selected;
+    ProcFile netDev;
+    InterfaceRows rows;
+    std::vector<double> rates;
+    std::vector<double> networkLoad;
+    CounterInstrumentation& instrumentation = Instrumentation::get("Network");
+    std::chrono::steady_clock::time_point prevTimePoint;
+    std::chrono::nanoseconds interval{0};
+    bool unsent = false;  // the last sample didn't fit into the caller's buffer
+};
+
+#else
+// not implemented
+namespace ov {
+namespace monitor {
+class NetworkPerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl(const std::vector<std::string>&, const std::string&) {}
+    std::vector<double> getNetworkLoad() {return {};}
+    SampleInfo sample(double*, std::size_t) {return {};}
+    const std::vector<std::string>& getInterfaces() const {return names;}
+    double getRate(Metric, std::size_t) const {return 0;}
+private:
+    std::vector<std::string> names;
+};
+#endif
+NetworkPerformanceCounter::NetworkPerformanceCounter(const std::vector<std::string>& interfaces,
+                                                     const std::string& procfsRoot) :
+    ov::monitor::PerformanceCounter("Network"), interfaces(interfaces), procfsRoot{procfsRoot} {}
+NetworkPerformanceCounter::~NetworkPerformanceCounter() {
+    delete performanceCounter;
+}
+NetworkPerformanceCounter::PerformanceCounterImpl& NetworkPerformanceCounter::impl() {
+    if (!performanceCounter)
+        performanceCounter = new PerformanceCounterImpl(interfaces, procfsRoot);
+    return *performanceCounter;
+}
+std::vector<double> NetworkPerformanceCounter::getLoad() {
+    return impl().getNetworkLoad();
+}
+SampleInfo NetworkPerformanceCounter::sample(double* load, std::size_t capacity) {
+    return impl().sample(load, capacity);
+}
+const std::vector<std::string>& NetworkPerformanceCounter::getInterfaces() {
+    return impl().getInterfaces();
+}
+double NetworkPerformanceCounter::getRate(Metric metric, std::size_t interface) {
+    return impl().getRate(metric, interface);
+}
+}
+}
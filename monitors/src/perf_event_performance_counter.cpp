@@ -0,0 +1,273 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/perf_event_performance_counter.h"
+#ifdef __linux__
+#include <chrono>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+struct EventType {
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+const EventType eventTypes[ov::monitor::PerfEventPerformanceCounter::EVENTS_NUMBER] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS},
+};
+
+int openEvent(int event, pid_t pid, int cpu, int groupFd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = eventTypes[event].type;
+    attr.config = eventTypes[event].config;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.disabled = groupFd < 0;
+    // a process may only count its own user space with perf_event_paranoid 2
+    attr.exclude_kernel = pid >= 0;
+    attr.inherit = pid >= 0;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, pid, cpu, groupFd, PERF_FLAG_FD_CLOEXEC));
+}
+}
+
+namespace ov {
+namespace monitor {
+class PerfEventPerformanceCounter::PerformanceCounterImpl {
+public:
+    explicit PerformanceCounterImpl(Scope scope) {
+        // keep room for the rest of the application, events above the budget are left unavailable
+        rlimit limit;
+        maxFds = getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY
+            ? static_cast<std::size_t>(limit.rlim_cur) / 2 : 512;
+        bool opened = false;
+        if (scope == SYSTEM) {
+            long nCpus = sysconf(_SC_NPROCESSORS_CONF);
+            cpus.resize(nCpus > 0 ? nCpus : 1);
+            for (std::size_t cpu = 0; cpu < cpus.size(); ++cpu)
+                opened = openCpu(cpus[cpu], -1, static_cast<int>(cpu)) || opened;
+            if (!opened) {
+                throw std::runtime_error("perf_event_open() failed for all system-wide events, see "
+                                         "/proc/sys/kernel/perf_event_paranoid or use the PROCESS scope");
+            }
+        } else {
+            cpus.resize(1);
+            opened = openCpu(cpus[0], getpid(), -1);
+            if (!opened) {
+                throw std::runtime_error("perf_event_open() failed for all events of the process, see "
+                                         "/proc/sys/kernel/perf_event_paranoid");
+            }
+        }
+        for (Cpu& cpu : cpus) {
+            for (Group& group : cpu.groups) {
+                if (!group.fds.empty())
+                    ioctl(group.fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+        }
+    }
+
+    ~PerformanceCounterImpl() {
+        for (Cpu& cpu : cpus) {
+            for (Group& group : cpu.groups) {
+                for (int fd : group.fds)
+                    close(fd);
+            }
+        }
+    }
+
+    std::vector<double> getPerfEventLoad() {
+        auto timePoint = std::chrono::steady_clock::now();
+        for (Cpu& cpu : cpus) {
+            for (Group& group : cpu.groups)
+                readGroup(group, cpu);
+        }
+        typedef std::chrono::duration<double, std::nano> Ns;
+        elapsed = std::chrono::duration_cast<Ns>(timePoint - prevTimePoint).count();
+        bool firstSample = prevTimePoint == std::chrono::steady_clock::time_point{};
+        prevTimePoint = timePoint;
+        if (firstSample)
+            return {};
+        std::vector<double> load(cpus.size(), 0.0);
+        // CPUs past the fd budget count 0 either way
+        bool ipc = false;
+        for (const Cpu& cpu : cpus)
+            ipc = ipc || (cpu.available[CYCLES] && cpu.available[INSTRUCTIONS]);
+        for (std::size_t i = 0; i < cpus.size(); ++i) {
+            const Cpu& cpu = cpus[i];
+            if (ipc) {
+                load[i] = cpu.deltas[CYCLES] > 0 ? cpu.deltas[INSTRUCTIONS] / cpu.deltas[CYCLES] : 0;
+            } else if (elapsed > 0) {
+                // the task clock of a CPU includes its idle task, so it can't tell busy time
+                load[i] = cpu.deltas[CONTEXT_SWITCHES] * 1e9 / elapsed;
+            }
+        }
+        return load;
+    }
+
+    std::size_t getNumberOfCpus() const {
+        return cpus.size();
+    }
+
+    bool isAvailable(Event event) const {
+        for (const Cpu& cpu : cpus) {
+            if (!cpu.available[event])
+                return false;
+        }
+        return true;
+    }
+
+    bool isAvailable(Event event, std::size_t cpu) const {
+        return cpu < cpus.size() && cpus[cpu].available[event];
+    }
+
+    double getDelta(Event event, std::size_t cpu) const {
+        return cpu < cpus.size() ? cpus[cpu].deltas[event] : 0;
+    }
+
+    double getRate(Event event, std::size_t cpu) const {
+        return elapsed > 0 ? getDelta(event, cpu) * 1e9 / elapsed : 0;
+    }
+
+private:
+    struct Group {
+        std::vector<int> fds;  // the leader first
+        std::vector<Event> events;
+        std::vector<std::uint64_t> values;
+        std::vector<std::uint64_t> buffer;
+        std::uint64_t enabled = 0;
+        std::uint64_t running = 0;
+    };
+
+    struct Cpu {
+        Group groups[2];  // hardware, software
+        double deltas[EVENTS_NUMBER] = {};
+        bool available[EVENTS_NUMBER] = {};
+    };
+
+    bool openCpu(Cpu& cpu, pid_t pid, int cpuIndex) {
+        static const Event groupEvents[2][3] = {{CYCLES, INSTRUCTIONS, CACHE_MISSES},
+                                                {TASK_CLOCK, CONTEXT_SWITCHES, CPU_MIGRATIONS}};
+        bool opened = false;
+        for (int g = 0; g < 2; ++g) {
+            Group& group = cpu.groups[g];
+            for (Event event : groupEvents[g]) {
+                if (fdsNumber >= maxFds)
+                    break;
+                // an event the PMU doesn't have is skipped, the next one may lead the group
+                int fd = openEvent(event, pid, cpuIndex, group.fds.empty() ? -1 : group.fds[0]);
+                if (fd < 0) {
+                    // out of fds, the events left are unavailable
+                    if (errno == EMFILE || errno == ENFILE)
+                        maxFds = fdsNumber;
+                    continue;
+                }
+                ++fdsNumber;
+                group.fds.push_back(fd);
+                group.events.push_back(event);
+                cpu.available[event] = true;
+            }
+            group.values.assign(group.events.size(), 0);
+            group.buffer.resize(3 + group.events.size());
+            opened = opened || !group.fds.empty();
+        }
+        return opened;
+    }
+
+    // {nr, time_enabled, time_running, values[nr]}, the deltas are scaled by the share of the time
+    // the group was on the PMU
+    void readGroup(Group& group, Cpu& cpu) {
+        if (group.fds.empty())
+            return;
+        std::size_t size = group.buffer.size() * sizeof(std::uint64_t);
+        ssize_t result = read(group.fds[0], group.buffer.data(), size);
+        if (result != static_cast<ssize_t>(size) || group.buffer[0] != group.events.size()) {
+            // the CPU went offline
+            for (Event event : group.events)
+                cpu.deltas[event] = 0;
+            return;
+        }
+        std::uint64_t enabled = group.buffer[1] - group.enabled;
+        std::uint64_t running = group.buffer[2] - group.running;
+        group.enabled = group.buffer[1];
+        group.running = group.buffer[2];
+        double scale = running > 0 ? static_cast<double>(enabled) / running : 0;
+        for (std::size_t i = 0; i < group.events.size(); ++i) {
+            std::uint64_t value = group.buffer[3 + i];
+            cpu.deltas[group.events[i]] = value >= group.values[i] ? (value - group.values[i]) * scale : 0;
+            group.values[i] = value;
+        }
+    }
+
+    std::vector<Cpu> cpus;
+    std::size_t maxFds;
+    std::size_t fdsNumber = 0;
+    double elapsed = 0;
+    std::chrono::steady_clock::time_point prevTimePoint;
+};
+
+#else
+// not implemented
+#include <stdexcept>
+namespace ov {
+namespace monitor {
+class PerfEventPerformanceCounter::PerformanceCounterImpl {
+public:
+    explicit PerformanceCounterImpl(Scope) {
+        throw std::runtime_error("perf_event is only available on Linux");
+    }
+    std::vector<double> getPerfEventLoad() {return {};}
+    std::size_t getNumberOfCpus() const {return 0;}
+    bool isAvailable(Event) const {return false;}
+    bool isAvailable(Event, std::size_t) const {return false;}
+    double getDelta(Event, std::size_t) const {return 0;}
+    double getRate(Event, std::size_t) const {return 0;}
+};
+#endif
+PerfEventPerformanceCounter::PerfEventPerformanceCounter(Scope scope) :
+    ov::monitor::PerformanceCounter("PerfEvent"), scope{scope} {}
+PerfEventPerformanceCounter::~PerfEventPerformanceCounter() {
+    delete performanceCounter;
+}
+PerfEventPerformanceCounter::PerformanceCounterImpl& PerfEventPerformanceCounter::impl() {
+    if (!performanceCounter)
+        performanceCounter = new PerformanceCounterImpl(scope);
+    return *performanceCounter;
+}
+std::vector<double> PerfEventPerformanceCounter::getLoad() {
+    return impl().getPerfEventLoad();
+}
+std::size_t PerfEventPerformanceCounter::getNumberOfCpus() {
+    return impl().getNumberOfCpus();
+}
+bool PerfEventPerformanceCounter::isAvailable(Event event) {
+    return impl().isAvailable(event);
+}
+bool PerfEventPerformanceCounter::isAvailable(Event event, std::size_t cpu) {
+    return impl().isAvailable(event, cpu);
+}
+PerfEventPerformanceCounter::Scope PerfEventPerformanceCounter::getScope() const {
+    return scope;
+}
+double PerfEventPerformanceCounter::getDelta(Event event, std::size_t cpu) {
+    return impl().getDelta(event, cpu);
+}
+double PerfEventPerformanceCounter::getRate(Event event, std::size_t cpu) {
+    return impl().getRate(event, cpu);
+}
+}
+}
@@ -0,0 +1,289 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/pressure_performance_counter.h"
+
+#include <algorithm>
+#include <stdexcept>
+#ifdef __linux__
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include "proc_file.h"
+
+namespace {
+const char* const resourceNames[ov::monitor::PressurePerformanceCounter::RESOURCES_NUMBER] = {"cpu", "io", "memory"};
+
+double parseField(const char* line, const char* lineEnd, const char* key) {
+    const char* field = std::strstr(line, key);
+    return field && field < lineEnd ? std::strtod(field + std::strlen(key), NULL) : 0;
+}
+
+// some avg10=0.91 avg60=1.27 avg300=1.31 total=27028265
+// full avg10=0.00 avg60=0.00 avg300=0.00 total=0
+void parsePressure(const char* data, ov::monitor::PressurePerformanceCounter::Pressure* pressures) {
+    for (const char* line = data; *line; line = ov::monitor::nextLine(line)) {
+        int scope = std::strncmp(line, "some ", 5) == 0 ? ov::monitor::PressurePerformanceCounter::SOME
+            : std::strncmp(line, "full ", 5) == 0 ? ov::monitor::PressurePerformanceCounter::FULL : -1;
+        if (scope < 0)
+            continue;
+        const char* lineEnd = ov::monitor::nextLine(line);
+        ov::monitor::PressurePerformanceCounter::Pressure& pressure = pressures[scope];
+        pressure.avg10 = parseField(line, lineEnd, "avg10=");
+        pressure.avg60 = parseField(line, lineEnd, "avg60=");
+        pressure.avg300 = parseField(line, lineEnd, "avg300=");
+        const char* total = std::strstr(line, "total=");
+        if (total && total < lineEnd)
+            ov::monitor::parseUnsigned(total + 6, pressure.total);
+    }
+}
+}
+
+namespace ov {
+namespace monitor {
+class PressurePerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl(const std::string& root) {
+        for (int resource = 0; resource < RESOURCES_NUMBER; ++resource) {
+            try {
+                files[resource].open(getPath(root, static_cast<Resource>(resource)), 256);
+            } catch (const std::system_error&) {
+                // the resource isn't accounted (e.g. the memory controller is disabled for the cgroup)
+            }
+        }
+    }
+
+    std::vector<double> getPressureLoad() {
+        auto timePoint = std::chrono::steady_clock::now();
+        for (int resource = 0; resource < RESOURCES_NUMBER; ++resource) {
+            for (int scope = 0; scope < SCOPES_NUMBER; ++scope)
+                prevTotals[resource][scope] = pressures[resource][scope].total;
+            if (!files[resource].isOpen())
+                continue;
+            std::size_t size;
+            parsePressure(files[resource].read(size), pressures[resource]);
+        }
+        bool firstSample = prevTimePoint == std::chrono::steady_clock::time_point{};
+        typedef std::chrono::duration<double, std::micro> Us;
+        double elapsed = std::chrono::duration_cast<Us>(timePoint - prevTimePoint).count();
+        prevTimePoint = timePoint;
+        if (firstSample || elapsed <= 0)
+            return {};
+        std::vector<double> load(RESOURCES_NUMBER * SCOPES_NUMBER);
+        for (int resource = 0; resource < RESOURCES_NUMBER; ++resource) {
+            for (int scope = 0; scope < SCOPES_NUMBER; ++scope) {
+                unsigned long long total = pressures[resource][scope].total;
+                unsigned long long prevTotal = prevTotals[resource][scope];
+                load[resource * SCOPES_NUMBER + scope] = total > prevTotal ? std::min(1.0, (total - prevTotal) / elapsed) : 0;
+            }
+        }
+        return load;
+    }
+
+    Pressure getPressure(Resource resource, Scope scope) const {
+        return pressures[resource][scope];
+    }
+
+private:
+    ProcFile files[RESOURCES_NUMBER];
+    Pressure pressures[RESOURCES_NUMBER][SCOPES_NUMBER];
+    unsigned long long prevTotals[RESOURCES_NUMBER][SCOPES_NUMBER] = {};
+    std::chrono::steady_clock::time_point prevTimePoint;
+};
+
+std::string PressurePerformanceCounter::getPath(const std::string& root, Resource resource) {
+    // /proc/pressure/cpu for the system, <cgroup>/cpu.pressure for a cgroup
+    std::string path = root + "/" + resourceNames[resource];
+    return access(path.c_str(), F_OK) == 0 ? path : path + ".pressure";
+}
+
+PressureTrigger::PressureTrigger(PressurePerformanceCounter::Resource resource, PressurePerformanceCounter::Scope scope,
+                                 std::chrono::microseconds stall, std::chrono::microseconds window,
+                                 const std::string& root) {
+    std::string path = PressurePerformanceCounter::getPath(root, resource);
+    fd = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(errno, std::system_category(), "open() failed for " + path);
+    }
+    char trigger[64];
+    int size = snprintf(trigger, sizeof(trigger), "%s %lld %lld", scope == PressurePerformanceCounter::SOME ? "some" : "full",
+                        static_cast<long long>(stall.count()), static_cast<long long>(window.count()));
+    // the kernel expects the terminating zero
+    if (write(fd, trigger, size + 1) < 0) {
+        int error = errno;
+        close(fd);
+        throw std::system_error(error, std::system_category(), "Can't register the PSI trigger \"" + std::string(trigger)
+                                + "\" for " + path);
+    }
+}
+
+PressureTrigger::~PressureTrigger() {
+    close(fd);
+}
+
+int PressureTrigger::getFd() const {
+    return fd;
+}
+
+bool PressureTrigger::wait(std::chrono::milliseconds timeout) {
+    pollfd event = {fd, POLLPRI, 0};
+    int result;
+    while ((result = poll(&event, 1, timeout.count() < 0 ? -1 : static_cast<int>(timeout.count()))) < 0 && errno == EINTR) {}
+    if (result < 0) {
+        throw std::system_error(errno, std::system_category(), "poll() failed");
+    }
+    if (event.revents & POLLERR) {
+        throw std::runtime_error("The pressure file of the trigger is gone");
+    }
+    return result > 0;
+}
+
+void PressureWatcher::start() {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (running)
+        return;
+    if (pipe2(wakeUpFds, O_CLOEXEC) != 0) {
+        throw std::system_error(errno, std::system_category(), "pipe2() failed");
+    }
+    running = true;
+    thread = std::thread{&PressureWatcher::watch, this};
+}
+
+void PressureWatcher::stop() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (!running)
+            return;
+    }
+    char wakeUp = 0;
+    while (write(wakeUpFds[1], &wakeUp, 1) < 0 && errno == EINTR) {}
+    thread.join();
+    std::lock_guard<std::mutex> lock{mutex};
+    close(wakeUpFds[0]);
+    close(wakeUpFds[1]);
+    wakeUpFds[0] = wakeUpFds[1] = -1;
+    running = false;
+}
+
+void PressureWatcher::watch() {
+    std::vector<pollfd> events(triggers.size() + 1);
+    for (std::size_t i = 0; i < triggers.size(); ++i)
+        events[i] = {triggers[i]->getFd(), POLLPRI, 0};
+    events.back() = {wakeUpFds[0], POLLIN, 0};
+    while (true) {
+        if (poll(events.data(), events.size(), -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+        if (events.back().revents)
+            return;
+        for (std::size_t i = 0; i < triggers.size(); ++i) {
+            if (events[i].revents & POLLERR) {
+                // the cgroup was removed, the trigger can't fire anymore
+                events[i].fd = -1;
+            } else if (events[i].revents & POLLPRI && callback) {
+                // like MonitorHub callbacks, a throwing callback must not stop the watcher
+                try {
+                    callback(i);
+                } catch (...) {
+                }
+            }
+        }
+    }
+}
+}
+}
+#else
+// not implemented
+namespace ov {
+namespace monitor {
+class PressurePerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl(const std::string&) {}
+    std::vector<double> getPressureLoad() {return {};}
+    Pressure getPressure(Resource, Scope) const {return {};}
+};
+
+std::string PressurePerformanceCounter::getPath(const std::string& root, Resource) {
+    return root;
+}
+
+PressureTrigger::PressureTrigger(PressurePerformanceCounter::Resource, PressurePerformanceCounter::Scope,
+                                 std::chrono::microseconds, std::chrono::microseconds, const std::string&) {
+    throw std::runtime_error("PSI triggers are only available on Linux");
+}
+
+PressureTrigger::~PressureTrigger() {}
+
+int PressureTrigger::getFd() const {
+    return fd;
+}
+
+bool PressureTrigger::wait(std::chrono::milliseconds) {
+    return false;
+}
+
+void PressureWatcher::start() {
+    throw std::runtime_error("PSI triggers are only available on Linux");
+}
+
+void PressureWatcher::stop() {}
+
+void PressureWatcher::watch() {}
+}
+}
+#endif
+
+namespace ov {
+namespace monitor {
+PressurePerformanceCounter::PressurePerformanceCounter(const std::string& root) :
+    ov::monitor::PerformanceCounter("Pressure"), root{root} {}
+PressurePerformanceCounter::~PressurePerformanceCounter() {
+    delete performanceCounter;
+}
+PressurePerformanceCounter::PerformanceCounterImpl& PressurePerformanceCounter::impl() {
+    if (!performanceCounter)
+        performanceCounter = new PerformanceCounterImpl(root);
+    return *performanceCounter;
+}
+std::vector<double> PressurePerformanceCounter::getLoad() {
+    return impl().getPressureLoad();
+}
+PressurePerformanceCounter::Pressure PressurePerformanceCounter::getPressure(Resource resource, Scope scope) {
+    return impl().getPressure(resource, scope);
+}
+
+PressureWatcher::~PressureWatcher() {
+    stop();
+}
+
+std::size_t PressureWatcher::addTrigger(const std::shared_ptr<PressureTrigger>& trigger) {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (running) {
+        throw std::logic_error("Triggers can't be added to a running PressureWatcher");
+    }
+    triggers.push_back(trigger);
+    return triggers.size() - 1;
+}
+
+void PressureWatcher::setCallback(const Callback& watcherCallback) {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (running) {
+        throw std::logic_error("The callback of a running PressureWatcher can't be changed");
+    }
+    callback = watcherCallback;
+}
+
+bool PressureWatcher::isRunning() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return running;
+}
+}
+}
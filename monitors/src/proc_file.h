@@ -0,0 +1,87 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace ov {
+namespace monitor {
+// A procfs/sysfs file kept open and re-read from the beginning with pread() into a reusable
+// buffer. The buffer only grows while the file doesn't fit into it, i.e. during warm up.
+class ProcFile {
+public:
+    ProcFile() = default;
+    explicit ProcFile(const std::string& path, std::size_t bufferSize = 4096) {
+        open(path, bufferSize);
+    }
+    ~ProcFile() {
+        if (fd >= 0)
+            close(fd);
+    }
+    ProcFile(const ProcFile&) = delete;
+    ProcFile& operator=(const ProcFile&) = delete;
+    ProcFile(ProcFile&& other) noexcept : fd{other.fd}, buffer{std::move(other.buffer)} {
+        other.fd = -1;
+    }
+
+    void open(const std::string& path, std::size_t bufferSize = 4096) {
+        if (fd >= 0)
+            close(fd);
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::system_error(errno, std::system_category(), "open() failed for " + path);
+        }
+        buffer.resize(bufferSize);
+    }
+
+    bool isOpen() const {
+        return fd >= 0;
+    }
+
+    // The whole file, null-terminated. Valid until the next read().
+    const char* read(std::size_t& size) {
+        for (;;) {
+            ssize_t result = pread(fd, buffer.data(), buffer.size() - 1, 0);
+            if (result < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::system_category(), "pread() failed");
+            }
+            if (static_cast<std::size_t>(result) < buffer.size() - 1) {
+                size = static_cast<std::size_t>(result);
+                buffer[size] = 0;
+                return buffer.data();
+            }
+            buffer.resize(buffer.size() * 2);
+        }
+    }
+
+private:
+    int fd = -1;
+    std::vector<char> buffer;
+};
+
+// Parses the unsigned number at p, skipping leading blanks; returns the position after it.
+inline const char* parseUnsigned(const char* p, unsigned long long& value) {
+    while (*p == ' ' || *p == '\t')
+        ++p;
+    value = 0;
+    while (*p >= '0' && *p <= '9')
+        value = value * 10 + static_cast<unsigned long long>(*p++ - '0');
+    return p;
+}
+
+inline const char* nextLine(const char* p) {
+    const char* lineEnd = std::strchr(p, '\n');
+    return lineEnd ? lineEnd + 1 : p + std::strlen(p);
+}
+}
+}
@@ -0,0 +1,146 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/proc_stat_parser.h"
+#include "monitors/instrumentation.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t'))
+        ++p;
+    return p;
+}
+
+inline const char* parseNumber(const char* p, const char* end, unsigned long long& value) {
+    value = 0;
+    while (p < end && isDigit(*p)) {
+        value = value * 10 + static_cast<unsigned long long>(*p - '0');
+        ++p;
+    }
+    return p;
+}
+}
+
+namespace ov {
+namespace monitor {
+ProcStatParser::ProcStatParser(std::size_t nCores, const std::string& path, bool firstCoresOnly) :
+    nCores{nCores},
+    firstCoresOnly{firstCoresOnly},
+    buffer(4096 + nCores * 128),
+    jiffies(COLUMNS_NUMBER * nCores, 0) {
+    fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(errno, std::system_category(), "open() failed for " + path);
+    }
+}
+
+ProcStatParser::~ProcStatParser() {
+    if (fd >= 0)
+        close(fd);
+}
+
+void ProcStatParser::update() {
+    bool instrumented = instrumentation && Instrumentation::isEnabled();
+    for (;;) {
+        auto start = instrumented ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+        ssize_t size = pread(fd, buffer.data(), buffer.size(), 0);
+        if (size < 0) {
+            if (errno == EINTR)
+                continue;
+            throw std::system_error(errno, std::system_category(), "pread() failed");
+        }
+        auto read = instrumented ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+        bool parsed = parse(static_cast<std::size_t>(size));
+        if (instrumented) {
+            instrumentation->record(CounterInstrumentation::READ, read - start);
+            instrumentation->record(CounterInstrumentation::PARSE, std::chrono::steady_clock::now() - read);
+        }
+        if (parsed)
+            return;
+        // the per-core lines didn't fit into the buffer, it only happens during warm up
+        buffer.resize(buffer.size() * 2);
+    }
+}
+
+void ProcStatParser::setInstrumentation(CounterInstrumentation* counterInstrumentation) {
+    instrumentation = counterInstrumentation;
+}
+
+bool ProcStatParser::parse(std::size_t size) {
+    std::fill(jiffies.begin(), jiffies.end(), 0);
+    listedCores = 0;
+    const char* p = buffer.data();
+    const char* end = p + size;
+    const bool truncated = size == buffer.size();
+    bool seenCores = false;
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (!lineEnd) {
+            if (truncated)
+                return false;
+            lineEnd = end;
+        }
+        if (lineEnd - p > 3 && p[0] == 'c' && p[1] == 'p' && p[2] == 'u') {
+            if (isDigit(p[3])) {
+                // it doesn't handle overflows of /proc/stat values
+                unsigned long long coreId;
+                const char* q = parseNumber(p + 3, lineEnd, coreId);
+                listedCores = std::max(listedCores, static_cast<std::size_t>(coreId + 1));
+                if (nCores <= coreId) {
+                    if (!firstCoresOnly)
+                        throw std::runtime_error("The number of cores has changed");
+                    p = lineEnd + 1;
+                    seenCores = true;
+                    continue;
+                }
+                for (std::size_t column = 0; column < COLUMNS_NUMBER; ++column) {
+                    q = skipSpaces(q, lineEnd);
+                    if (q == lineEnd || !isDigit(*q))
+                        break;
+                    q = parseNumber(q, lineEnd, jiffies[column * nCores + coreId]);
+                }
+                seenCores = true;
+            }
+        } else if (seenCores) {
+            // per-core lines are contiguous, the rest of the file is not needed
+            return true;
+        }
+        p = lineEnd + 1;
+    }
+    return !truncated;
+}
+
+std::size_t ProcStatParser::getNumberOfCores() const {
+    return nCores;
+}
+
+std::size_t ProcStatParser::getListedCores() const {
+    return listedCores;
+}
+
+const unsigned long long* ProcStatParser::getColumn(Column column) const {
+    return jiffies.data() + column * nCores;
+}
+
+unsigned long long ProcStatParser::getJiffies(Column column, std::size_t core) const {
+    return jiffies[column * nCores + core];
+}
+
+unsigned long long ProcStatParser::getIdleJiffies(std::size_t core) const {
+    return jiffies[IDLE * nCores + core] + jiffies[IOWAIT * nCores + core];
+}
+}
+}
@@ -0,0 +1,301 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <algorithm>
+#include "monitors/performance_counter.h"
+#include "monitors/process_performance_counter.h"
+#ifdef __linux__
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_map>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace {
+const long clockTicks = sysconf(_SC_CLK_TCK);
+
+int parseId(const char* name) {
+    int id = 0;
+    for (; *name; ++name) {
+        if (*name < '0' || *name > '9')
+            return 0;
+        id = id * 10 + (*name - '0');
+    }
+    return id;
+}
+
+// utime + stime and starttime of /proc/<pid>/stat. The command name may contain spaces and
+// parentheses, so fields are counted from the last ')'.
+bool parseTaskStat(const char* data, std::size_t size, unsigned long long& cpuTime, unsigned long long& startTime) {
+    const char* p = static_cast<const char*>(memrchr(data, ')', size));
+    if (!p)
+        return false;
+    const char* end = data + size;
+    unsigned long long utime = 0, stime = 0;
+    // fields after the command: 1 is state, 12 utime, 13 stime, 20 starttime
+    for (int field = 0; field < 20; ++field) {
+        while (p < end && *p != ' ')
+            ++p;
+        while (p < end && *p == ' ')
+            ++p;
+        if (p == end)
+            return false;
+        if (field + 1 == 12 || field + 1 == 13 || field + 1 == 20) {
+            unsigned long long value = 0;
+            while (p < end && *p >= '0' && *p <= '9')
+                value = value * 10 + static_cast<unsigned long long>(*p++ - '0');
+            if (field + 1 == 12)
+                utime = value;
+            else if (field + 1 == 13)
+                stime = value;
+            else
+                startTime = value;
+        }
+    }
+    cpuTime = utime + stime;
+    return true;
+}
+}
+
+namespace ov {
+namespace monitor {
+class ProcessPerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl(bool perThread, std::size_t topN, const std::string& procfsRoot) :
+        perThread{perThread}, topN{topN} {
+        procDir = opendir(procfsRoot.c_str());
+        if (!procDir) {
+            throw std::system_error(errno, std::system_category(), "opendir() failed for " + procfsRoot);
+        }
+        // keep room for the rest of the application, tasks above the budget are opened on every sample
+        rlimit limit;
+        maxPersistentFds = getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY
+            ? static_cast<std::size_t>(limit.rlim_cur) / 2 : 512;
+    }
+
+    ~PerformanceCounterImpl() {
+        for (auto& process : processes)
+            closeProcess(process.second);
+        closedir(procDir);
+    }
+
+    std::vector<double> getProcessLoad() {
+        auto timePoint = std::chrono::steady_clock::now();
+        typedef std::chrono::duration<double, std::chrono::seconds::period> Sec;
+        double elapsed = std::chrono::duration_cast<Sec>(timePoint - prevTimePoint).count();
+        bool firstSample = generation == 0;
+        ++generation;
+        prevTimePoint = timePoint;
+
+        const int procFd = dirfd(procDir);
+        char path[64];
+        rewinddir(procDir);
+        while (dirent* entry = readdir(procDir)) {
+            int pid = parseId(entry->d_name);
+            if (pid <= 0)
+                continue;
+            Process& process = processes[pid];
+            snprintf(path, sizeof(path), "%d/stat", pid);
+            if (!sampleTask(process.task, procFd, path, elapsed))
+                continue;
+            if (perThread)
+                sampleThreads(pid, process, elapsed);
+        }
+
+        processLoads.clear();
+        threadLoads.clear();
+        for (auto it = processes.begin(); it != processes.end();) {
+            Process& process = it->second;
+            if (process.task.generation != generation) {
+                // the process has exited
+                closeProcess(process);
+                it = processes.erase(it);
+                continue;
+            }
+            if (process.task.sampled)
+                processLoads.push_back({it->first, it->first, process.task.load});
+            for (auto thread = process.threads.begin(); thread != process.threads.end();) {
+                if (thread->second.generation != generation) {
+                    closeTask(thread->second);
+                    thread = process.threads.erase(thread);
+                    continue;
+                }
+                if (thread->second.sampled)
+                    threadLoads.push_back({it->first, thread->first, thread->second.load});
+                ++thread;
+            }
+            ++it;
+        }
+        selectTop(processLoads);
+        selectTop(threadLoads);
+        if (firstSample)
+            return {};
+        std::vector<double> loads(processLoads.size());
+        for (std::size_t i = 0; i < processLoads.size(); ++i)
+            loads[i] = processLoads[i].load;
+        return loads;
+    }
+
+    const std::vector<TaskLoad>& getProcesses() const {
+        return processLoads;
+    }
+
+    const std::vector<TaskLoad>& getThreads() const {
+        return threadLoads;
+    }
+
+private:
+    struct Task {
+        int fd = -1;
+        unsigned long long startTime = 0;
+        unsigned long long cpuTime = 0;
+        unsigned generation = 0;
+        bool sampled = false;
+        double load = 0;
+    };
+
+    struct Process {
+        Task task;
+        DIR* taskDir = NULL;
+        std::unordered_map<int, Task> threads;
+    };
+
+    bool sampleTask(Task& task, int dirFd, const char* path, double elapsed) {
+        bool transient = false;
+        if (task.fd < 0) {
+            task.fd = openat(dirFd, path, O_RDONLY | O_CLOEXEC);
+            if (task.fd < 0)
+                return false;
+            transient = persistentFds >= maxPersistentFds;
+            if (!transient)
+                ++persistentFds;
+        }
+        ssize_t size = pread(task.fd, buffer, sizeof(buffer), 0);
+        if (transient) {
+            close(task.fd);
+            task.fd = -1;
+        }
+        unsigned long long cpuTime, startTime;
+        if (size <= 0 || !parseTaskStat(buffer, static_cast<std::size_t>(size), cpuTime, startTime))
+            return false;
+        // a new task, or the id was reused since the previous sample
+        task.sampled = task.generation != 0 && task.generation + 1 == generation && task.startTime == startTime && elapsed > 0;
+        if (task.sampled)
+            task.load = (cpuTime >= task.cpuTime ? cpuTime - task.cpuTime : 0) / static_cast<double>(clockTicks) / elapsed;
+        task.cpuTime = cpuTime;
+        task.startTime = startTime;
+        task.generation = generation;
+        return true;
+    }
+
+    void sampleThreads(int pid, Process& process, double elapsed) {
+        char path[64];
+        if (!process.taskDir) {
+            snprintf(path, sizeof(path), "%d/task", pid);
+            int fd = openat(dirfd(procDir), path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (fd < 0)
+                return;
+            process.taskDir = fdopendir(fd);
+            if (!process.taskDir) {
+                close(fd);
+                return;
+            }
+            ++persistentFds;
+        } else {
+            rewinddir(process.taskDir);
+        }
+        const int taskFd = dirfd(process.taskDir);
+        while (dirent* entry = readdir(process.taskDir)) {
+            int tid = parseId(entry->d_name);
+            if (tid <= 0)
+                continue;
+            snprintf(path, sizeof(path), "%d/stat", tid);
+            sampleTask(process.threads[tid], taskFd, path, elapsed);
+        }
+    }
+
+    void selectTop(std::vector<TaskLoad>& loads) const {
+        auto busier = [](const TaskLoad& a, const TaskLoad& b) { return a.load > b.load; };
+        if (topN && topN < loads.size()) {
+            std::partial_sort(loads.begin(), loads.begin() + topN, loads.end(), busier);
+            loads.resize(topN);
+        } else {
+            std::sort(loads.begin(), loads.end(), busier);
+        }
+    }
+
+    void closeTask(Task& task) {
+        if (task.fd >= 0) {
+            close(task.fd);
+            --persistentFds;
+            task.fd = -1;
+        }
+    }
+
+    void closeProcess(Process& process) {
+        closeTask(process.task);
+        for (auto& thread : process.threads)
+            closeTask(thread.second);
+        if (process.taskDir) {
+            closedir(process.taskDir);
+            --persistentFds;
+        }
+        process.taskDir = NULL;
+    }
+
+    bool perThread;
+    std::size_t topN;
+    DIR* procDir;
+    std::unordered_map<int, Process> processes;
+    std::vector<TaskLoad> processLoads;
+    std::vector<TaskLoad> threadLoads;
+    std::size_t persistentFds = 0;
+    std::size_t maxPersistentFds;
+    unsigned generation = 0;
+    std::chrono::steady_clock::time_point prevTimePoint;
+    char buffer[1024];
+};
+
+#else
+// not implemented
+namespace ov {
+namespace monitor {
+class ProcessPerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl(bool, std::size_t, const std::string&) {}
+    std::vector<double> getProcessLoad() {return {};}
+    const std::vector<TaskLoad>& getProcesses() const {return loads;}
+    const std::vector<TaskLoad>& getThreads() const {return loads;}
+private:
+    std::vector<TaskLoad> loads;
+};
+#endif
+ProcessPerformanceCounter::ProcessPerformanceCounter(bool perThread, std::size_t topN, const std::string& procfsRoot) :
+    ov::monitor::PerformanceCounter("Process"), perThread{perThread}, topN{topN}, procfsRoot{procfsRoot} {}
+ProcessPerformanceCounter::~ProcessPerformanceCounter() {
+    delete performanceCounter;
+}
+std::vector<double> ProcessPerformanceCounter::getLoad() {
+    if (!performanceCounter)
+        performanceCounter = new PerformanceCounterImpl(perThread, topN, procfsRoot);
+    return performanceCounter->getProcessLoad();
+}
+const std::vector<ProcessPerformanceCounter::TaskLoad>& ProcessPerformanceCounter::getProcesses() {
+    if (!performanceCounter)
+        performanceCounter = new PerformanceCounterImpl(perThread, topN, procfsRoot);
+    return performanceCounter->getProcesses();
+}
+const std::vector<ProcessPerformanceCounter::TaskLoad>& ProcessPerformanceCounter::getThreads() {
+    if (!performanceCounter)
+        performanceCounter = new PerformanceCounterImpl(perThread, topN, procfsRoot);
+    return performanceCounter->getThreads();
+}
+}
+}
@@ -0,0 +1,144 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/replay_performance_counter.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include "monitors/cpu_load_calculator.h"
+
+namespace ov {
+namespace monitor {
+RecordingPerformanceCounter::RecordingPerformanceCounter(
+    const std::shared_ptr<ov::monitor::PerformanceCounter>& performanceCounter, const std::string& path) :
+    ov::monitor::PerformanceCounter(performanceCounter->name(), performanceCounter->getCounterName()),
+    performanceCounter{performanceCounter}, path{path} {}
+
+std::vector<double> RecordingPerformanceCounter::getLoad() {
+    std::vector<double> load = performanceCounter->getLoad();
+    if (load.empty())
+        return load;
+    // the width of a frame is known after the first sample
+    if (!recorder) {
+        width = load.size();
+        recorder.reset(new SampleRecorder(path, SampleKind::LOAD, width));
+    }
+    if (load.size() != width) {
+        throw std::runtime_error("The number of values has changed during recording");
+    }
+    recorder->write(std::chrono::steady_clock::now().time_since_epoch(), load.data());
+    return load;
+}
+
+class ReplayPerformanceCounter::PerformanceCounterImpl {
+public:
+    PerformanceCounterImpl(const std::string& path, Speed speed, bool loop) :
+        recording{path},
+        speed{speed},
+        loop{loop},
+        cpuLoad{recording.getWidth(), recording.getClockTicks()} {
+        if (recording.size() == 0) {
+            throw std::runtime_error(path + " has no samples");
+        }
+        if (recording.getKind() == SampleKind::IDLE_JIFFIES && recording.getClockTicks() <= 0) {
+            throw std::runtime_error(path + " has no clock ticks");
+        }
+        // a looped replay of the baseline frame alone would never produce a sample
+        if (recording.getKind() == SampleKind::IDLE_JIFFIES && recording.size() < 2) {
+            throw std::runtime_error(path + " has no samples after the baseline frame");
+        }
+    }
+
+    std::vector<double> getLoad() {
+        std::vector<double> load(recording.getWidth());
+        if (sample(load.data(), load.size()).status == SampleInfo::OK)
+            return load;
+        return {};
+    }
+
+    // Timestamps are the replay times of the frames, intervals are the recorded ones.
+    SampleInfo sample(double* load, std::size_t capacity) {
+        SampleInfo info;
+        if (capacity < recording.getWidth()) {
+            info.status = SampleInfo::BUFFER_TOO_SMALL;
+            info.size = recording.getWidth();
+            return info;
+        }
+        while (true) {
+            if (frame == recording.size()) {
+                if (!loop) {
+                    return info;
+                }
+                frame = 0;
+                replayStart += recording.getTimestamp(recording.size() - 1) - recording.getTimestamp(0);
+            }
+            if (frame == 0 && replayStart == std::chrono::steady_clock::time_point{}) {
+                replayStart = std::chrono::steady_clock::now();
+            }
+            if (speed == RECORDED_SPEED) {
+                std::this_thread::sleep_until(replayStart + (recording.getTimestamp(frame) - recording.getTimestamp(0)));
+            }
+            std::size_t current = frame++;
+            info.timestamp = replayStart + (recording.getTimestamp(current) - recording.getTimestamp(0));
+            if (recording.getKind() == SampleKind::LOAD) {
+                const double* frameLoad = recording.getLoad(current);
+                std::copy(frameLoad, frameLoad + recording.getWidth(), load);
+                if (current > 0)
+                    info.interval = recording.getTimestamp(current) - recording.getTimestamp(current - 1);
+                info.status = SampleInfo::OK;
+                info.size = recording.getWidth();
+                return info;
+            }
+            // the first frame is the baseline the live counter takes on creation
+            if (current == 0) {
+                cpuLoad.reset(recording.getJiffies(0), recording.getTimestamp(0));
+                continue;
+            }
+            std::chrono::nanoseconds prevTimePoint = cpuLoad.getPrevTimePoint();
+            if (cpuLoad.update(recording.getJiffies(current), recording.getTimestamp(current), load)) {
+                info.interval = recording.getTimestamp(current) - prevTimePoint;
+                info.status = SampleInfo::OK;
+                info.size = recording.getWidth();
+            }
+            return info;
+        }
+    }
+
+    bool finished() const {
+        return !loop && frame == recording.size();
+    }
+
+    std::size_t getNumberOfFrames() const {
+        return recording.size();
+    }
+
+private:
+    SampleRecording recording;
+    Speed speed;
+    bool loop;
+    CpuLoadCalculator cpuLoad;
+    std::size_t frame = 0;
+    std::chrono::steady_clock::time_point replayStart;
+};
+
+ReplayPerformanceCounter::ReplayPerformanceCounter(const std::string& path, Speed speed, bool loop) :
+    ov::monitor::PerformanceCounter("Replay"), performanceCounter{new PerformanceCounterImpl(path, speed, loop)} {}
+ReplayPerformanceCounter::~ReplayPerformanceCounter() {
+    delete performanceCounter;
+}
+std::vector<double> ReplayPerformanceCounter::getLoad() {
+    return performanceCounter->getLoad();
+}
+SampleInfo ReplayPerformanceCounter::sample(double* load, std::size_t capacity) {
+    return performanceCounter->sample(load, capacity);
+}
+bool ReplayPerformanceCounter::finished() const {
+    return performanceCounter->finished();
+}
+std::size_t ReplayPerformanceCounter::getNumberOfFrames() const {
+    return performanceCounter->getNumberOfFrames();
+}
+}
+}
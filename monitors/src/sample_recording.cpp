@@ -0,0 +1,133 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/sample_recording.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+const char recordingMagic[4] = {'O', 'V', 'S', 'R'};
+const std::uint32_t recordingVersion = 1;
+
+struct RecordingHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t kind;
+    std::uint32_t width;
+    std::int64_t clockTicks;
+};
+}
+
+namespace ov {
+namespace monitor {
+SampleRecorder::SampleRecorder(const std::string& path, SampleKind kind, std::size_t width, long clockTicks) :
+    file{std::fopen(path.c_str(), "wb")}, kind{kind}, width{width} {
+    if (!file) {
+        throw std::runtime_error("Can't open " + path + " for recording");
+    }
+    RecordingHeader header;
+    std::memcpy(header.magic, recordingMagic, sizeof(header.magic));
+    header.version = recordingVersion;
+    header.kind = static_cast<std::uint32_t>(kind);
+    header.width = static_cast<std::uint32_t>(width);
+    header.clockTicks = clockTicks;
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+        std::fclose(file);
+        throw std::runtime_error("Can't write the recording header to " + path);
+    }
+}
+
+SampleRecorder::~SampleRecorder() {
+    std::fclose(file);
+}
+
+void SampleRecorder::write(std::chrono::nanoseconds timestamp, const double* values) {
+    if (kind != SampleKind::LOAD) {
+        throw std::logic_error("The recording doesn't store loads");
+    }
+    writeFrame(timestamp, values);
+}
+
+void SampleRecorder::write(std::chrono::nanoseconds timestamp, const unsigned long long* values) {
+    if (kind != SampleKind::IDLE_JIFFIES) {
+        throw std::logic_error("The recording doesn't store jiffies");
+    }
+    writeFrame(timestamp, values);
+}
+
+void SampleRecorder::writeFrame(std::chrono::nanoseconds timestamp, const void* values) {
+    static_assert(sizeof(double) == 8 && sizeof(unsigned long long) == 8, "frame values must be 8 bytes");
+    std::int64_t ns = timestamp.count();
+    if (std::fwrite(&ns, sizeof(ns), 1, file) != 1 || std::fwrite(values, 8, width, file) != width) {
+        throw std::runtime_error("Can't write a recording frame");
+    }
+}
+
+void SampleRecorder::flush() {
+    std::fflush(file);
+}
+
+SampleRecording::SampleRecording(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        throw std::runtime_error("Can't open recording " + path);
+    }
+    RecordingHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || std::memcmp(header.magic, recordingMagic, 4) != 0
+        || header.version != recordingVersion
+        || header.kind > static_cast<std::uint32_t>(SampleKind::IDLE_JIFFIES)) {
+        std::fclose(file);
+        throw std::runtime_error(path + " is not a supported recording");
+    }
+    kind = static_cast<SampleKind>(header.kind);
+    width = header.width;
+    clockTicks = static_cast<long>(header.clockTicks);
+
+    std::vector<unsigned char> frame(8 + 8 * width);
+    while (std::fread(frame.data(), frame.size(), 1, file) == 1) {
+        std::int64_t ns;
+        std::memcpy(&ns, frame.data(), sizeof(ns));
+        timestamps.push_back(ns);
+        if (kind == SampleKind::LOAD) {
+            loads.resize(loads.size() + width);
+            std::memcpy(loads.data() + loads.size() - width, frame.data() + 8, 8 * width);
+        } else {
+            jiffies.resize(jiffies.size() + width);
+            std::memcpy(jiffies.data() + jiffies.size() - width, frame.data() + 8, 8 * width);
+        }
+    }
+    // a truncated last frame (e.g. the recorder was killed) is ignored
+    std::fclose(file);
+}
+
+SampleKind SampleRecording::getKind() const {
+    return kind;
+}
+
+std::size_t SampleRecording::getWidth() const {
+    return width;
+}
+
+long SampleRecording::getClockTicks() const {
+    return clockTicks;
+}
+
+std::size_t SampleRecording::size() const {
+    return timestamps.size();
+}
+
+std::chrono::nanoseconds SampleRecording::getTimestamp(std::size_t frame) const {
+    return std::chrono::nanoseconds{timestamps[frame]};
+}
+
+const double* SampleRecording::getLoad(std::size_t frame) const {
+    return loads.data() + frame * width;
+}
+
+const unsigned long long* SampleRecording::getJiffies(std::size_t frame) const {
+    return jiffies.data() + frame * width;
+}
+}
+}
@@ -0,0 +1,256 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/shared_snapshot.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#ifndef _WIN32
+#include <cerrno>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+const char segmentMagic[8] = {'O', 'V', 'S', 'N', 'A', 'P', '1', 0};
+const unsigned maxReadAttempts = 1000;
+
+struct SegmentHeader {
+    char magic[8];
+    std::uint32_t maxDevices;
+    std::uint32_t maxValues;
+    std::uint32_t historySize;
+    std::atomic<std::uint32_t> closed;
+    std::uint64_t slotBytes;
+};
+
+// followed by load[maxValues], mean[maxValues] and history[historySize][maxValues]
+struct SlotHeader {
+    std::atomic<std::uint32_t> sequence;  // odd while the slot is being written
+    std::uint32_t valuesNumber;
+    std::uint32_t samplesNumber;
+    std::uint32_t reserved;
+    std::uint64_t updates;
+    std::int64_t timestamp;
+    char name[32];
+};
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "The segment layout expects plain atomics");
+
+std::size_t slotBytes(std::size_t maxValues, std::size_t historySize) {
+    std::size_t bytes = sizeof(SlotHeader) + (2 + historySize) * maxValues * sizeof(double);
+    return (bytes + 63) / 64 * 64;  // slots don't share cache lines
+}
+
+const SegmentHeader& header(const std::uint8_t* segment) {
+    return *reinterpret_cast<const SegmentHeader*>(segment);
+}
+
+std::size_t slotOffset(const std::uint8_t* segment, std::size_t device) {
+    return (sizeof(SegmentHeader) + 63) / 64 * 64 + device * header(segment).slotBytes;
+}
+}
+
+namespace ov {
+namespace monitor {
+std::size_t SnapshotPublisher::getMaxDevices() const {
+    return header(segment).maxDevices;
+}
+
+void SnapshotPublisher::publish(std::size_t device, const std::string& deviceName, const LoadHistory& history) {
+    if (device >= getMaxDevices()) {
+        throw std::out_of_range("The device doesn't fit into the snapshot segment");
+    }
+    if (history.size() == 0)
+        return;
+    const SegmentHeader& segmentHeader = header(segment);
+    SlotHeader& slot = *reinterpret_cast<SlotHeader*>(segment + slotOffset(segment, device));
+    double* load = reinterpret_cast<double*>(&slot + 1);
+    double* mean = load + segmentHeader.maxValues;
+    double* ring = mean + segmentHeader.maxValues;
+    std::uint32_t valuesNumber = static_cast<std::uint32_t>(
+        std::min<std::size_t>(history.getNumberOfCores(), segmentHeader.maxValues));
+
+    std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    if (slot.valuesNumber != valuesNumber || deviceName.compare(slot.name) != 0) {
+        // a new device or a new number of cores, the old samples can't be read anymore
+        slot.valuesNumber = valuesNumber;
+        slot.samplesNumber = 0;
+        std::memset(slot.name, 0, sizeof(slot.name));
+        deviceName.copy(slot.name, sizeof(slot.name) - 1);
+    }
+    double* sample = ring + slot.updates % segmentHeader.historySize * segmentHeader.maxValues;
+    for (std::size_t core = 0; core < valuesNumber; ++core) {
+        load[core] = history.at(history.size() - 1, core);
+        mean[core] = history.getMean(core);
+        sample[core] = load[core];
+    }
+    slot.samplesNumber = std::min(slot.samplesNumber + 1, segmentHeader.historySize);
+    ++slot.updates;
+    slot.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+std::size_t SnapshotReader::getMaxDevices() const {
+    return header(segment).maxDevices;
+}
+
+std::size_t SnapshotReader::getMaxValues() const {
+    return header(segment).maxValues;
+}
+
+std::size_t SnapshotReader::getHistorySize() const {
+    return header(segment).historySize;
+}
+
+bool SnapshotReader::isClosed() const {
+    return header(segment).closed.load(std::memory_order_acquire) != 0;
+}
+
+bool SnapshotReader::read(std::size_t device, Snapshot& snapshot, bool withHistory) const {
+    if (device >= getMaxDevices()) {
+        throw std::out_of_range("The device doesn't exist in the snapshot segment");
+    }
+    const SegmentHeader& segmentHeader = header(segment);
+    const SlotHeader& slot = *reinterpret_cast<const SlotHeader*>(segment + slotOffset(segment, device));
+    const double* load = reinterpret_cast<const double*>(&slot + 1);
+    const double* mean = load + segmentHeader.maxValues;
+    const double* ring = mean + segmentHeader.maxValues;
+    for (unsigned attempt = 0; attempt < maxReadAttempts; ++attempt) {
+        std::uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence & 1)
+            continue;
+        std::size_t valuesNumber = std::min<std::size_t>(slot.valuesNumber, segmentHeader.maxValues);
+        std::size_t samplesNumber = std::min<std::size_t>(slot.samplesNumber, segmentHeader.historySize);
+        std::uint64_t updates = slot.updates;
+        snapshot.updates = updates;
+        snapshot.timestamp = std::chrono::nanoseconds{slot.timestamp};
+        std::memcpy(snapshot.name, slot.name, sizeof(snapshot.name));
+        snapshot.load.resize(valuesNumber);
+        snapshot.mean.resize(valuesNumber);
+        std::memcpy(snapshot.load.data(), load, valuesNumber * sizeof(double));
+        std::memcpy(snapshot.mean.data(), mean, valuesNumber * sizeof(double));
+        snapshot.history.resize(withHistory ? samplesNumber * valuesNumber : 0);
+        if (withHistory) {
+            for (std::size_t i = 0; i < samplesNumber; ++i) {
+                std::size_t position = (updates - samplesNumber + i) % segmentHeader.historySize;
+                std::memcpy(snapshot.history.data() + i * valuesNumber, ring + position * segmentHeader.maxValues,
+                            valuesNumber * sizeof(double));
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+            snapshot.name[sizeof(snapshot.name) - 1] = 0;
+            return updates != 0;
+        }
+    }
+    return false;
+}
+
+#ifdef _WIN32
+// not implemented
+SnapshotPublisher::SnapshotPublisher(const std::string&, std::size_t, std::size_t, std::size_t) {
+    throw std::runtime_error("SnapshotPublisher is not implemented on Windows");
+}
+
+SnapshotPublisher::~SnapshotPublisher() {}
+
+SnapshotReader::SnapshotReader(const std::string&) {
+    throw std::runtime_error("SnapshotReader is not implemented on Windows");
+}
+
+SnapshotReader::~SnapshotReader() {}
+#else
+SnapshotPublisher::SnapshotPublisher(const std::string& name, std::size_t maxDevices, std::size_t maxValues,
+                                     std::size_t historySize) : name{name} {
+    if (maxDevices == 0 || maxValues == 0 || historySize == 0) {
+        throw std::invalid_argument("The snapshot segment can't be empty");
+    }
+    std::size_t slotSize = slotBytes(maxValues, historySize);
+    size = (sizeof(SegmentHeader) + 63) / 64 * 64 + maxDevices * slotSize;
+
+    // readers keep the old segment mapped, they see it closed
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd >= 0) {
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) == 0 && static_cast<std::size_t>(fileStat.st_size) >= sizeof(SegmentHeader)) {
+            void* old = mmap(NULL, sizeof(SegmentHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (old != MAP_FAILED) {
+                static_cast<SegmentHeader*>(old)->closed.store(1, std::memory_order_release);
+                munmap(old, sizeof(SegmentHeader));
+            }
+        }
+        close(fd);
+        shm_unlink(name.c_str());
+    }
+    fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        throw std::system_error(errno, std::system_category(), "shm_open() failed for " + name);
+    }
+    void* mapped = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+        mapped = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int error = errno;
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw std::system_error(error, std::system_category(), "Can't map the shared memory " + name);
+    }
+    // the pages are zeroed: every slot starts unpublished with an even sequence
+    segment = static_cast<std::uint8_t*>(mapped);
+    SegmentHeader& segmentHeader = *reinterpret_cast<SegmentHeader*>(segment);
+    segmentHeader.maxDevices = static_cast<std::uint32_t>(maxDevices);
+    segmentHeader.maxValues = static_cast<std::uint32_t>(maxValues);
+    segmentHeader.historySize = static_cast<std::uint32_t>(historySize);
+    segmentHeader.slotBytes = slotSize;
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(segmentHeader.magic, segmentMagic, sizeof(segmentMagic));
+}
+
+SnapshotPublisher::~SnapshotPublisher() {
+    reinterpret_cast<SegmentHeader*>(segment)->closed.store(1, std::memory_order_release);
+    munmap(segment, size);
+    shm_unlink(name.c_str());
+}
+
+SnapshotReader::SnapshotReader(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::system_error(errno, std::system_category(), "shm_open() failed for " + name);
+    }
+    struct stat fileStat;
+    void* mapped = MAP_FAILED;
+    if (fstat(fd, &fileStat) == 0 && static_cast<std::size_t>(fileStat.st_size) >= sizeof(SegmentHeader)) {
+        size = static_cast<std::size_t>(fileStat.st_size);
+        mapped = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Can't map the shared memory " + name);
+    }
+    segment = static_cast<const std::uint8_t*>(mapped);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const SegmentHeader& segmentHeader = header(segment);
+    if (std::memcmp(segmentHeader.magic, segmentMagic, sizeof(segmentMagic)) != 0
+        || slotOffset(segment, segmentHeader.maxDevices) > size
+        || segmentHeader.slotBytes < slotBytes(segmentHeader.maxValues, segmentHeader.historySize)) {
+        munmap(const_cast<std::uint8_t*>(segment), size);
+        throw std::runtime_error(name + " is not a snapshot segment");
+    }
+}
+
+SnapshotReader::~SnapshotReader() {
+    munmap(const_cast<std::uint8_t*>(segment), size);
+}
+#endif
+}
+}
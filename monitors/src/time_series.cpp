@@ -0,0 +1,455 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "monitors/time_series.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "bit_stream.h"
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#include <io.h>
+#else
+#include <cerrno>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+const char fileMagic[4] = {'O', 'V', 'T', 'S'};
+const char blockMagic[4] = {'O', 'V', 'T', 'B'};
+const std::uint32_t fileVersion = 1;
+
+struct FileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t width;
+    std::uint32_t reserved;
+    std::int64_t resolution;  // ns per timestamp unit
+};
+
+struct BlockHeader {
+    char magic[4];
+    std::uint32_t count;
+    std::int64_t firstTimestamp;
+    std::int64_t lastTimestamp;
+    std::uint32_t payloadBytes;
+    std::uint32_t reserved;
+};
+
+// both are only called with a non-zero value
+unsigned countLeadingZeros(std::uint64_t value) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_clzll(value));
+#else
+    unsigned n = 0;
+    for (std::uint64_t bit = 1ULL << 63; !(value & bit); bit >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+unsigned countTrailingZeros(std::uint64_t value) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+    unsigned n = 0;
+    for (; !(value & 1); value >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+std::uint64_t toBits(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double fromBits(std::uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Delta-of-delta buckets: '0', '10' + 7 bits, '110' + 9 bits, '1110' + 12 bits, '1111' + 64 bits.
+void writeDeltaOfDelta(ov::monitor::BitWriter& writer, std::int64_t dod) {
+    if (dod == 0) {
+        writer.write(0, 1);
+    } else if (dod >= -63 && dod <= 64) {
+        writer.write(0x2, 2);
+        writer.write(static_cast<std::uint64_t>(dod + 63), 7);
+    } else if (dod >= -255 && dod <= 256) {
+        writer.write(0x6, 3);
+        writer.write(static_cast<std::uint64_t>(dod + 255), 9);
+    } else if (dod >= -2047 && dod <= 2048) {
+        writer.write(0xE, 4);
+        writer.write(static_cast<std::uint64_t>(dod + 2047), 12);
+    } else {
+        writer.write(0xF, 4);
+        writer.write(static_cast<std::uint64_t>(dod), 64);
+    }
+}
+
+// Drops the torn tail a crash in the middle of a write leaves behind.
+void truncateFile(const std::string& path, long size) {
+#ifdef _WIN32
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    bool truncated = file && _chsize_s(_fileno(file), size) == 0;
+    if (file)
+        std::fclose(file);
+#else
+    bool truncated = truncate(path.c_str(), size) == 0;
+#endif
+    if (!truncated) {
+        throw std::runtime_error("Can't truncate " + path);
+    }
+}
+
+std::int64_t readDeltaOfDelta(ov::monitor::BitReader& reader) {
+    if (!reader.readBit())
+        return 0;
+    if (!reader.readBit())
+        return static_cast<std::int64_t>(reader.read(7)) - 63;
+    if (!reader.readBit())
+        return static_cast<std::int64_t>(reader.read(9)) - 255;
+    if (!reader.readBit())
+        return static_cast<std::int64_t>(reader.read(12)) - 2047;
+    return static_cast<std::int64_t>(reader.read(64));
+}
+}
+
+namespace ov {
+namespace monitor {
+TimeSeriesWriter::TimeSeriesWriter(const std::string& path, std::size_t width, std::chrono::nanoseconds resolution,
+                                   std::size_t samplesPerBlock) :
+    width{width},
+    resolution{std::max<std::int64_t>(resolution.count(), 1)},
+    samplesPerBlock{std::max<std::size_t>(samplesPerBlock, 1)},
+    payload{new BitWriter},
+    prevValues(width),
+    prevLeading(width),
+    prevTrailing(width) {
+    if (std::FILE* existing = std::fopen(path.c_str(), "rb")) {
+        std::fseek(existing, 0, SEEK_END);
+        long fileSize = std::ftell(existing);
+        std::rewind(existing);
+        FileHeader header;
+        bool valid = std::fread(&header, sizeof(header), 1, existing) == 1;
+        bool empty = !valid && std::feof(existing);
+        if (!empty && (!valid || std::memcmp(header.magic, fileMagic, 4) != 0 || header.version != fileVersion
+                       || header.width != width || header.resolution != this->resolution)) {
+            std::fclose(existing);
+            throw std::runtime_error(path + " is not a time series file of the same width and resolution");
+        }
+        // appended samples must not go back in time past the blocks already written
+        long end = valid ? static_cast<long>(sizeof(header)) : 0;
+        BlockHeader block;
+        while (valid && std::fread(&block, sizeof(block), 1, existing) == 1
+               && std::memcmp(block.magic, blockMagic, 4) == 0
+               && end + static_cast<long>(sizeof(block) + block.payloadBytes) <= fileSize) {
+            prevTimestamp = block.lastTimestamp;
+            end += sizeof(block) + block.payloadBytes;
+            std::fseek(existing, end, SEEK_SET);
+        }
+        std::fclose(existing);
+        // readers stop at the first incomplete block, so new blocks must not be appended behind it
+        if (end < fileSize)
+            truncateFile(path, end);
+    }
+    file = std::fopen(path.c_str(), "ab");
+    if (!file) {
+        throw std::runtime_error("Can't open " + path + " for writing");
+    }
+    std::fseek(file, 0, SEEK_END);
+    if (std::ftell(file) == 0) {
+        FileHeader header = {};
+        std::memcpy(header.magic, fileMagic, 4);
+        header.version = fileVersion;
+        header.width = static_cast<std::uint32_t>(width);
+        header.resolution = this->resolution;
+        if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+            std::fclose(file);
+            throw std::runtime_error("Can't write the header of " + path);
+        }
+    }
+}
+
+TimeSeriesWriter::~TimeSeriesWriter() {
+    try {
+        flush();
+    } catch (...) {
+    }
+    std::fclose(file);
+}
+
+void TimeSeriesWriter::append(std::chrono::nanoseconds timestamp, const double* values) {
+    std::int64_t units = timestamp.count() / resolution;
+    if (units < prevTimestamp) {
+        throw std::logic_error("Time series timestamps must not decrease");
+    }
+    if (count == 0) {
+        firstTimestamp = units;
+        prevDelta = 0;
+        for (std::size_t i = 0; i < width; ++i) {
+            prevValues[i] = toBits(values[i]);
+            payload->write(prevValues[i], 64);
+            prevLeading[i] = 65;  // no window yet
+            prevTrailing[i] = 0;
+        }
+    } else {
+        std::int64_t delta = units - prevTimestamp;
+        writeDeltaOfDelta(*payload, delta - prevDelta);
+        prevDelta = delta;
+        for (std::size_t i = 0; i < width; ++i) {
+            std::uint64_t bits = toBits(values[i]);
+            std::uint64_t xored = bits ^ prevValues[i];
+            prevValues[i] = bits;
+            if (xored == 0) {
+                payload->write(0, 1);
+                continue;
+            }
+            unsigned leading = std::min(countLeadingZeros(xored), 31u);
+            unsigned trailing = countTrailingZeros(xored);
+            if (prevLeading[i] <= 64 && leading >= prevLeading[i] && trailing >= prevTrailing[i]) {
+                // fits into the previous meaningful bits window
+                payload->write(0x2, 2);
+                payload->write(xored >> prevTrailing[i], 64 - prevLeading[i] - prevTrailing[i]);
+            } else {
+                unsigned length = 64 - leading - trailing;
+                payload->write(0x3, 2);
+                payload->write(leading, 5);
+                payload->write(length - 1, 6);
+                payload->write(xored >> trailing, length);
+                prevLeading[i] = leading;
+                prevTrailing[i] = trailing;
+            }
+        }
+    }
+    prevTimestamp = units;
+    if (++count == samplesPerBlock)
+        flush();
+}
+
+void TimeSeriesWriter::flush() {
+    if (count == 0) {
+        std::fflush(file);
+        return;
+    }
+    BlockHeader header = {};
+    std::memcpy(header.magic, blockMagic, 4);
+    header.count = static_cast<std::uint32_t>(count);
+    header.firstTimestamp = firstTimestamp;
+    header.lastTimestamp = prevTimestamp;
+    header.payloadBytes = static_cast<std::uint32_t>(payload->data().size());
+    count = 0;
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1
+        && std::fwrite(payload->data().data(), 1, payload->data().size(), file) == payload->data().size();
+    payload->clear();
+    std::fflush(file);
+    if (!written) {
+        throw std::runtime_error("Can't write a time series block");
+    }
+}
+
+std::size_t TimeSeriesWriter::getWidth() const {
+    return width;
+}
+
+std::chrono::nanoseconds TimeSeriesWriter::getLastTimestamp() const {
+    if (prevTimestamp == std::numeric_limits<std::int64_t>::min())
+        return std::chrono::nanoseconds::min();
+    return std::chrono::nanoseconds{prevTimestamp * resolution};
+}
+
+TimeSeriesReader::TimeSeriesReader(const std::string& path) : path{path} {
+    map();
+}
+
+TimeSeriesReader::~TimeSeriesReader() {
+    unmap();
+}
+
+void TimeSeriesReader::refresh() {
+    unmap();
+    map();
+}
+
+void TimeSeriesReader::map() {
+#ifdef _WIN32
+    std::ifstream file{path, std::ios::binary};
+    if (!file) {
+        throw std::runtime_error("Can't open " + path);
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+#else
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(errno, std::system_category(), "open() failed for " + path);
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0) {
+        int error = errno;
+        close(fd);
+        throw std::system_error(error, std::system_category(), "fstat() failed for " + path);
+    }
+    size = static_cast<std::size_t>(fileStat.st_size);
+    if (size > 0) {
+        void* mapped = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::system_category(), "mmap() failed for " + path);
+        }
+        data = static_cast<const std::uint8_t*>(mapped);
+    }
+    close(fd);
+#endif
+    FileHeader header;
+    if (size < sizeof(header)) {
+        unmap();
+        throw std::runtime_error(path + " is not a time series file");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, fileMagic, 4) != 0 || header.version != fileVersion) {
+        unmap();
+        throw std::runtime_error(path + " is not a time series file");
+    }
+    width = header.width;
+    resolution = header.resolution;
+
+    // only the block headers are read, a block being written (truncated) ends the index
+    blocks.clear();
+    samplesNumber = 0;
+    std::size_t offset = sizeof(header);
+    while (offset + sizeof(BlockHeader) <= size) {
+        BlockHeader blockHeader;
+        std::memcpy(&blockHeader, data + offset, sizeof(blockHeader));
+        if (std::memcmp(blockHeader.magic, blockMagic, 4) != 0)
+            break;
+        offset += sizeof(blockHeader);
+        if (offset + blockHeader.payloadBytes > size)
+            break;
+        blocks.push_back(Block{offset, blockHeader.payloadBytes, blockHeader.count,
+                               blockHeader.firstTimestamp, blockHeader.lastTimestamp});
+        samplesNumber += blockHeader.count;
+        offset += blockHeader.payloadBytes;
+    }
+}
+
+void TimeSeriesReader::unmap() {
+#ifndef _WIN32
+    if (data)
+        munmap(const_cast<std::uint8_t*>(data), size);
+#endif
+    buffer.clear();
+    data = NULL;
+    size = 0;
+}
+
+std::size_t TimeSeriesReader::getWidth() const {
+    return width;
+}
+
+std::size_t TimeSeriesReader::getNumberOfBlocks() const {
+    return blocks.size();
+}
+
+std::size_t TimeSeriesReader::getNumberOfSamples() const {
+    return samplesNumber;
+}
+
+std::chrono::nanoseconds TimeSeriesReader::getFirstTimestamp() const {
+    return std::chrono::nanoseconds{blocks.empty() ? 0 : blocks.front().firstTimestamp * resolution};
+}
+
+std::chrono::nanoseconds TimeSeriesReader::getLastTimestamp() const {
+    return std::chrono::nanoseconds{blocks.empty() ? 0 : blocks.back().lastTimestamp * resolution};
+}
+
+std::size_t TimeSeriesReader::scan(std::chrono::nanoseconds from, std::chrono::nanoseconds to,
+                                   const Visitor& visitor) const {
+    // timestamps don't decrease, so the blocks are sorted by time
+    std::int64_t fromUnits = from.count() / resolution + (from.count() % resolution > 0 ? 1 : 0);
+    std::int64_t toUnits = to.count() / resolution - (to.count() % resolution < 0 ? 1 : 0);
+    auto first = std::lower_bound(blocks.begin(), blocks.end(), fromUnits,
+                                  [](const Block& block, std::int64_t timestamp) { return block.lastTimestamp < timestamp; });
+    std::size_t visited = 0;
+    for (auto block = first; block != blocks.end() && block->firstTimestamp <= toUnits; ++block)
+        decode(*block, fromUnits, toUnits, visitor, visited);
+    return visited;
+}
+
+void TimeSeriesReader::decode(const Block& block, std::int64_t from, std::int64_t to, const Visitor& visitor,
+                              std::size_t& visited) const {
+    BitReader reader{data + block.offset, block.payloadBytes};
+    std::vector<std::uint64_t> bits(width);
+    std::vector<double> values(width);
+    std::vector<unsigned> leading(width, 0);
+    std::vector<unsigned> trailing(width, 0);
+    std::int64_t timestamp = block.firstTimestamp;
+    std::int64_t delta = 0;
+    for (std::size_t sample = 0; sample < block.count; ++sample) {
+        if (sample == 0) {
+            for (std::size_t i = 0; i < width; ++i)
+                bits[i] = reader.read(64);
+        } else {
+            delta += readDeltaOfDelta(reader);
+            timestamp += delta;
+            for (std::size_t i = 0; i < width; ++i) {
+                if (!reader.readBit())
+                    continue;
+                if (reader.readBit()) {
+                    leading[i] = static_cast<unsigned>(reader.read(5));
+                    unsigned length = static_cast<unsigned>(reader.read(6)) + 1;
+                    trailing[i] = 64 - leading[i] - length;
+                }
+                bits[i] ^= reader.read(64 - leading[i] - trailing[i]) << trailing[i];
+            }
+        }
+        if (timestamp > to)
+            return;
+        if (timestamp >= from) {
+            for (std::size_t i = 0; i < width; ++i)
+                values[i] = fromBits(bits[i]);
+            visitor(std::chrono::nanoseconds{timestamp * resolution}, values.data());
+            ++visited;
+        }
+    }
+}
+
+ArchivingPerformanceCounter::ArchivingPerformanceCounter(
+    const std::shared_ptr<ov::monitor::PerformanceCounter>& performanceCounter, const std::string& path) :
+    ov::monitor::PerformanceCounter(performanceCounter->name(), performanceCounter->getCounterName()),
+    performanceCounter{performanceCounter}, path{path} {}
+
+std::vector<double> ArchivingPerformanceCounter::getLoad() {
+    std::vector<double> load = performanceCounter->getLoad();
+    if (load.empty())
+        return load;
+    // the width is known after the first sample
+    if (!writer)
+        writer.reset(new TimeSeriesWriter(path, load.size()));
+    if (load.size() != writer->getWidth()) {
+        throw std::runtime_error("The number of values has changed during archiving");
+    }
+    // the wall clock may step back, e.g. when NTP corrects it: such samples keep the last timestamp
+    std::chrono::nanoseconds timestamp = std::chrono::system_clock::now().time_since_epoch();
+    writer->append(std::max(timestamp, writer->getLastTimestamp()), load.data());
+    return load;
+}
+
+void ArchivingPerformanceCounter::flush() {
+    if (writer)
+        writer->flush();
+}
+}
+}
@@ -0,0 +1,67 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// CgroupPerformanceCounter against fake cgroupfs and procfs trees.
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "monitors/cgroup_performance_counter.h"
+#include "test_utils.h"
+
+namespace {
+const std::chrono::milliseconds interval{400};
+
+std::string cpuStat(unsigned long long usageUsec, unsigned long long nrPeriods = 0,
+                    unsigned long long nrThrottled = 0) {
+    return "usage_usec " + std::to_string(usageUsec) + "\nuser_usec " + std::to_string(usageUsec)
+        + "\nsystem_usec 0\nnr_periods " + std::to_string(nrPeriods) + "\nnr_throttled "
+        + std::to_string(nrThrottled) + "\nthrottled_usec 0\n";
+}
+}
+
+int main() {
+    test::TempDir root;
+    root.write("cgroup/cgroup.controllers", "cpu memory\n");
+    root.write("cgroup/a.slice/cpu.stat", cpuStat(1000000));
+    root.write("cgroup/a.slice/cpu.max", "200000 100000\n");
+    root.write("cgroup/b.slice/c.scope/cpu.stat", cpuStat(0));
+    root.write("cgroup/b.slice/c.scope/cpu.max", "max 100000\n");
+    root.write("proc/100/cgroup", "1:name=systemd:/x\n0::/b.slice/c.scope\n");
+    root.write("proc/101/cgroup", "0::/\n");
+
+    CHECK(ov::monitor::CgroupPerformanceCounter::getProcessCgroup(root.path() + "/proc", "100") == "/b.slice/c.scope");
+    CHECK(ov::monitor::CgroupPerformanceCounter::getProcessCgroup(root.path() + "/proc", "101").empty());
+
+    // the paths are the same cgroups with and without the leading and trailing slashes
+    for (const char* path : {"a.slice", "/a.slice", "a.slice/"}) {
+        ov::monitor::CgroupPerformanceCounter counter{{path, "b.slice/c.scope"}, root.path() + "/cgroup"};
+        CHECK(counter.getLoad().empty());
+        CHECK(counter.getStat(0).usageUsec == 1000000);
+        CHECK(counter.getStat(0).quota == 2);
+        CHECK(counter.getStat(1).quota == 0);
+    }
+
+    // a cgroup using one CPU out of a quota of two, then throttled in half of its periods
+    ov::monitor::CgroupPerformanceCounter counter{{"/a.slice"}, root.path() + "/cgroup"};
+    CHECK(counter.getLoad().empty());
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(interval);
+    double elapsedUsec = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    root.write("cgroup/a.slice/cpu.stat", cpuStat(1000000 + static_cast<unsigned long long>(elapsedUsec), 4, 2));
+    std::vector<double> load = counter.getLoad();
+    CHECK(load.size() == 1);
+    CHECK(!load.empty() && load[0] > 0.35 && load[0] <= 0.5);
+    CHECK(counter.getThrottledPeriodsRatio(0) == 0.5);
+
+    // a hybrid layout keeps cgroup v2 under unified/
+    root.write("hybrid/unified/cgroup.controllers", "cpu\n");
+    root.write("hybrid/unified/a.slice/cpu.stat", cpuStat(7));
+    ov::monitor::CgroupPerformanceCounter hybrid{{"a.slice"}, root.path() + "/hybrid"};
+    CHECK(hybrid.getLoad().empty());
+    CHECK(hybrid.getStat(0).usageUsec == 7 && hybrid.getStat(0).quota == 0);
+
+    return test::result();
+}
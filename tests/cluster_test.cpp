@@ -0,0 +1,229 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// Many ClusterAgents against one ClusterCollector over loopback UDP and a Unix socket, checking that every
+// frame arrives and that the collector keeps exactly the loads that were sent.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "monitors/cluster.h"
+#include "test_utils.h"
+
+namespace {
+const std::size_t agentsNumber = 16;
+const std::size_t ticks = 50;
+const std::size_t cpuCores = 4;
+
+// Multiples of 1/64 survive the f32 encoding exactly.
+double cpuLoad(std::size_t agent, std::size_t tick, std::size_t core) {
+    return static_cast<double>((agent + tick + core) % 64) / 64;
+}
+
+double gpuLoad(std::size_t agent, std::size_t tick) {
+    return static_cast<double>((agent * 3 + tick) % 64) / 64;
+}
+
+std::string hostName(std::size_t agent) {
+    return "node-" + std::to_string(agent);
+}
+
+// The datagram queue of a Unix socket is short (net.unix.max_dgram_qlen), so the agents keep at most window
+// frames in flight: an agent sends only once the collector has received all but window - 1 of the frames
+// sent before.
+class FlowControl {
+public:
+    FlowControl(const ov::monitor::ClusterCollector& collector, std::uint64_t window) :
+        collector(collector), window{window} {}
+
+    template <typename Send>
+    void send(Send send) {
+        std::lock_guard<std::mutex> lock{mutex};
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (sent - collector.getStats().frames >= window && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::microseconds{100});
+        send();
+        ++sent;
+    }
+
+    std::uint64_t getSent() const {
+        std::lock_guard<std::mutex> lock{mutex};
+        return sent;
+    }
+
+private:
+    const ov::monitor::ClusterCollector& collector;
+    std::uint64_t window;
+    mutable std::mutex mutex;
+    std::uint64_t sent = 0;
+};
+
+void checkFleet(const std::string& endpoint, std::uint64_t window) {
+    ov::monitor::ClusterCollector collector{endpoint};
+    collector.start();
+    std::string target = collector.getEndpoint();
+    FlowControl flowControl{collector, window};
+    std::atomic<std::uint64_t> dropped{0};
+    std::vector<std::thread> agents;
+    for (std::size_t agent = 0; agent < agentsNumber; ++agent) {
+        agents.emplace_back([&, agent] {
+            ov::monitor::ClusterAgent clusterAgent{target, hostName(agent)};
+            for (std::size_t tick = 0; tick < ticks; ++tick) {
+                double cpu[cpuCores];
+                for (std::size_t core = 0; core < cpuCores; ++core)
+                    cpu[core] = cpuLoad(agent, tick, core);
+                double gpu = gpuLoad(agent, tick);
+                clusterAgent.append("CPU", cpu, cpuCores);
+                clusterAgent.append("GPU", &gpu, 1);
+                flowControl.send([&clusterAgent] { clusterAgent.flush(); });
+            }
+            dropped += clusterAgent.getDroppedFrames();
+        });
+    }
+    for (std::thread& agent : agents)
+        agent.join();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (collector.getStats().frames < flowControl.getSent() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    collector.stop();
+
+    ov::monitor::ClusterCollector::Stats stats = collector.getStats();
+    CHECK(dropped == 0);
+    CHECK(stats.frames == agentsNumber * ticks);
+    CHECK(stats.samples == agentsNumber * ticks * 2);
+    CHECK(stats.lostFrames == 0);
+    CHECK(stats.malformedFrames == 0);
+    CHECK(stats.reorderedFrames == 0);
+    CHECK(collector.getHosts().size() == agentsNumber);
+
+    double cpuMin = 1, cpuMax = 0, cpuSum = 0;
+    for (std::size_t agent = 0; agent < agentsNumber; ++agent) {
+        ov::monitor::ClusterCollector::HostLoad host;
+        CHECK(collector.getHostLoad(hostName(agent), host));
+        CHECK(host.frames == ticks);
+        CHECK(host.lostFrames == 0);
+        CHECK(host.devices.size() == 2);
+        double mean = 0;
+        for (std::size_t core = 0; core < cpuCores; ++core)
+            mean += cpuLoad(agent, ticks - 1, core);
+        mean /= cpuCores;
+        cpuMin = std::min(cpuMin, mean);
+        cpuMax = std::max(cpuMax, mean);
+        cpuSum += mean;
+        for (const ov::monitor::ClusterCollector::DeviceLoad& device : host.devices) {
+            CHECK(device.samples == ticks);
+            if (device.device == "CPU") {
+                CHECK(device.load.size() == cpuCores);
+                for (std::size_t core = 0; core < cpuCores && core < device.load.size(); ++core)
+                    CHECK(device.load[core] == cpuLoad(agent, ticks - 1, core));
+                CHECK(device.mean == mean);
+            } else {
+                CHECK(device.device == "GPU");
+                CHECK(device.load.size() == 1);
+                CHECK(!device.load.empty() && device.load[0] == gpuLoad(agent, ticks - 1));
+            }
+        }
+    }
+
+    std::vector<ov::monitor::ClusterCollector::FleetLoad> fleet = collector.getFleetLoad();
+    CHECK(fleet.size() == 2);
+    if (fleet.size() == 2) {
+        CHECK(fleet[0].device == "CPU");
+        CHECK(fleet[0].hosts == agentsNumber);
+        CHECK(fleet[0].samples == agentsNumber * ticks);
+        CHECK(fleet[0].min == cpuMin);
+        CHECK(fleet[0].max == cpuMax);
+        CHECK(std::abs(fleet[0].mean - cpuSum / agentsNumber) < 1e-12);
+        CHECK(fleet[1].device == "GPU");
+        CHECK(fleet[1].hosts == agentsNumber);
+    }
+}
+
+// A frame as the agents encode it, with one sample.
+std::vector<char> encodeFrame(const std::string& host, std::uint32_t sequence, const std::string& device,
+                              float load) {
+    std::vector<char> frame;
+    auto put = [&frame](std::uint64_t value, std::size_t bytes) {
+        for (std::size_t i = 0; i < bytes; ++i)
+            frame.push_back(static_cast<char>(value >> (8 * i)));
+    };
+    put(0x464d564f, 4);
+    put(1, 1);
+    put(host.size(), 1);
+    frame.insert(frame.end(), host.begin(), host.end());
+    put(sequence, 4);
+    put(1, 2);
+    put(device.size(), 1);
+    frame.insert(frame.end(), device.begin(), device.end());
+    put(1, 2);
+    put(0, 8);
+    std::uint32_t bits;
+    memcpy(&bits, &load, sizeof(bits));
+    put(bits, 4);
+    return frame;
+}
+
+void checkSequences() {
+    ov::monitor::ClusterCollector collector{"udp://127.0.0.1:0"};
+    auto ingest = [&collector](std::uint32_t sequence, float load) {
+        std::vector<char> frame = encodeFrame("node", sequence, "CPU", load);
+        return collector.ingest(frame.data(), frame.size());
+    };
+    ov::monitor::ClusterCollector::HostLoad host;
+    CHECK(ingest(0, 0.25f));
+    CHECK(ingest(1, 0.5f));
+    CHECK(ingest(2, 0.75f));
+    // a duplicate and a late frame neither rewind the sequence nor overwrite the newer load
+    CHECK(ingest(2, 0.125f));
+    CHECK(ingest(1, 0.125f));
+    CHECK(ingest(3, 1));
+    CHECK(collector.getStats().reorderedFrames == 2);
+    CHECK(collector.getStats().lostFrames == 0);
+    CHECK(collector.getHostLoad("node", host) && host.devices[0].load[0] == 1);
+    // frames 4 and 5 are lost
+    CHECK(ingest(6, 0.5f));
+    CHECK(collector.getStats().lostFrames == 2);
+    // an agent restart starts again from 0
+    CHECK(ingest(0, 0.25f));
+    CHECK(ingest(1, 0.5f));
+    CHECK(collector.getStats().lostFrames == 2);
+    CHECK(collector.getStats().frames == 7);
+    CHECK(collector.getHostLoad("node", host) && host.devices[0].load[0] == 0.5);
+}
+
+// A sample too big for the default frame size still gets through in a frame of its own.
+void checkBigSample() {
+    ov::monitor::ClusterCollector collector{"udp://127.0.0.1:0"};
+    collector.start();
+    ov::monitor::ClusterAgent agent{collector.getEndpoint(), "big"};
+    std::vector<double> load(3000, 0.5);
+    agent.append("CPU", load.data(), load.size());
+    agent.flush();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (collector.getStats().frames == 0 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    collector.stop();
+    ov::monitor::ClusterCollector::HostLoad host;
+    CHECK(agent.getSentFrames() == 1);
+    CHECK(collector.getStats().frames == 1);
+    CHECK(collector.getStats().malformedFrames == 0);
+    CHECK(collector.getHostLoad("big", host) && host.devices[0].load.size() == 3000);
+}
+}
+
+int main() {
+    checkSequences();
+    checkBigSample();
+    checkFleet("udp://127.0.0.1:0", 64);
+    checkFleet("unix:///tmp/monitors_cluster_test." + std::to_string(getpid()) + ".sock", 4);
+    return test::result();
+}
@@ -0,0 +1,96 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// GpuPerformanceCounter against fake sysfs and procfs trees, no GPU needed.
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "monitors/gpu_performance_counter.h"
+#include "test_utils.h"
+
+namespace {
+const std::chrono::milliseconds interval{400};
+
+std::string fdinfo(unsigned long long clientId, unsigned long long renderNs) {
+    return "pos:\t0\nflags:\t02100002\ndrm-driver:\ti915\ndrm-pdev:\t0000:00:02.0\ndrm-client-id:\t"
+        + std::to_string(clientId) + "\ndrm-engine-render:\t" + std::to_string(renderNs)
+        + " ns\ndrm-engine-compute:\t0 ns\n";
+}
+}
+
+int main() {
+    test::TempDir root;
+    // an Intel card with a connector, and a card of another vendor
+    root.write("sys/devices/pci0000:00/0000:00:02.0/vendor", "0x8086\n");
+    root.write("sys/devices/pci0000:00/0000:01:00.0/vendor", "0x10de\n");
+    root.symlink("sys/class/drm/card0/device", "../../../devices/pci0000:00/0000:00:02.0");
+    root.symlink("sys/class/drm/card1/device", "../../../devices/pci0000:00/0000:01:00.0");
+    root.mkdir("sys/class/drm/card0-DP-1");
+    // process 100 uses client 7 through two fds
+    root.symlink("proc/100/fd/0", "/dev/null");
+    root.symlink("proc/100/fd/5", "/dev/dri/renderD128");
+    root.symlink("proc/100/fd/6", "/dev/dri/renderD128");
+    root.write("proc/100/fdinfo/0", "pos:\t0\n");
+    root.write("proc/100/fdinfo/5", fdinfo(7, 0));
+    root.write("proc/100/fdinfo/6", fdinfo(7, 0));
+
+    ov::monitor::GpuPerformanceCounter counter{root.path() + "/sys", root.path() + "/proc"};
+    CHECK(counter.getLoad().empty());
+
+    // 160 ms of render time, seen through both fds, is accounted once
+    std::this_thread::sleep_for(interval);
+    root.write("proc/100/fdinfo/5", fdinfo(7, 160000000));
+    root.write("proc/100/fdinfo/6", fdinfo(7, 160000000));
+    std::vector<double> load = counter.getLoad();
+    CHECK(load.size() == 1);
+    CHECK(!load.empty() && load[0] > 0.15 && load[0] < 0.45);
+
+    // known clients are read through the fd opened first, also after a rescan: replacing the file behind the
+    // path must not matter
+    int original = open((root.path() + "/proc/100/fdinfo/5").c_str(), O_WRONLY | O_CLOEXEC);
+    CHECK(original >= 0);
+    root.write("proc/100/fdinfo/5.new", fdinfo(7, 160000000));
+    CHECK(std::rename((root.path() + "/proc/100/fdinfo/5.new").c_str(),
+                      (root.path() + "/proc/100/fdinfo/5").c_str()) == 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds{1100} - interval);
+    load = counter.getLoad();
+    CHECK(!load.empty() && load[0] == 0);
+    std::string busy = fdinfo(7, 320000000);
+    CHECK(ftruncate(original, 0) == 0);
+    CHECK(pwrite(original, busy.data(), busy.size(), 0) == static_cast<ssize_t>(busy.size()));
+    close(original);
+    std::this_thread::sleep_for(interval);
+    load = counter.getLoad();
+    CHECK(!load.empty() && load[0] > 0.15 && load[0] < 0.45);
+
+    // a client started later is picked up by the next rescan and accounted from then on; a known process is
+    // only walked again by the full rescan, so its new client isn't accounted yet
+    root.symlink("proc/200/fd/3", "/dev/dri/renderD128");
+    root.write("proc/200/fdinfo/3", fdinfo(8, 5000000000ULL));
+    root.symlink("proc/100/fd/7", "/dev/dri/renderD128");
+    root.write("proc/100/fdinfo/7", fdinfo(9, 0));
+    std::this_thread::sleep_for(std::chrono::milliseconds{1100});
+    load = counter.getLoad();
+    CHECK(!load.empty() && load[0] == 0);
+    root.write("proc/200/fdinfo/3", fdinfo(8, 5000000000ULL + 160000000));
+    root.write("proc/100/fdinfo/7", fdinfo(9, 160000000));
+    std::this_thread::sleep_for(interval);
+    load = counter.getLoad();
+    CHECK(!load.empty() && load[0] > 0.15 && load[0] < 0.45);
+
+    // without devices there is nothing to wait for: an idle load right away
+    test::TempDir empty;
+    empty.mkdir("sys/class/drm");
+    empty.mkdir("proc");
+    ov::monitor::GpuPerformanceCounter none{empty.path() + "/sys", empty.path() + "/proc"};
+    load = none.getLoad();
+    CHECK(load.size() == 1 && load[0] == 0);
+
+    return test::result();
+}
@@ -0,0 +1,103 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// MetricsExporter scraped over localhost, next to clients that stall.
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "monitors/metrics_exporter.h"
+#include "test_utils.h"
+
+namespace {
+int connectTo(unsigned short port) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// The whole response, or what came within the timeout.
+std::string get(unsigned short port, const std::string& path, int timeoutMs = 500) {
+    int fd = connectTo(port);
+    if (fd < 0)
+        return "";
+    std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+    std::string response;
+    pollfd client = {fd, POLLIN, 0};
+    char buffer[4096];
+    while (poll(&client, 1, timeoutMs) > 0) {
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received <= 0)
+            break;
+        response.append(buffer, received);
+    }
+    close(fd);
+    return response;
+}
+
+bool contains(const std::string& text, const char* part) {
+    return text.find(part) != std::string::npos;
+}
+}
+
+int main() {
+    ov::monitor::MetricsExporter exporter{0};
+    exporter.addMetric("ov_cpu_load", "CPU load.", "core");
+    exporter.start();
+    unsigned short port = exporter.getPort();
+    CHECK(exporter.isRunning() && port != 0);
+
+    ov::monitor::MonitorHub::Batch batch;
+    batch.tick = 3;
+    batch.samples.resize(1);
+    batch.samples[0].status = ov::monitor::MonitorHub::Sample::OK;
+    batch.samples[0].load = {0.25, 0.5};
+    exporter.publish(batch);
+
+    std::string response = get(port, "/metrics");
+    CHECK(contains(response, "HTTP/1.1 200 OK\r\n"));
+    CHECK(contains(response, "ov_monitor_ticks_total 3\n"));
+    CHECK(contains(response, "ov_cpu_load{core=\"0\"} 0.25\n"));
+    CHECK(contains(response, "ov_cpu_load{core=\"1\"} 0.5\n"));
+    CHECK(contains(response, "# EOF\n"));
+    CHECK(contains(get(port, "/other"), "404 Not Found"));
+
+    // clients that connect and send nothing, or only a part of the request, don't hold up a scrape
+    int idle = connectTo(port);
+    int partial = connectTo(port);
+    CHECK(idle >= 0 && partial >= 0);
+    send(partial, "GET /met", 8, MSG_NOSIGNAL);
+    auto start = std::chrono::steady_clock::now();
+    CHECK(contains(get(port, "/"), "ov_cpu_load{core=\"1\"} 0.5\n"));
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::milliseconds{500});
+
+    // they are dropped once their deadline has passed
+    pollfd stalled = {idle, POLLIN, 0};
+    CHECK(poll(&stalled, 1, 3000) == 1);
+    char byte;
+    CHECK(recv(idle, &byte, 1, 0) == 0);
+
+    // and stop() doesn't wait for them
+    start = std::chrono::steady_clock::now();
+    exporter.stop();
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::milliseconds{500});
+    CHECK(!exporter.isRunning());
+    close(idle);
+    close(partial);
+
+    return test::result();
+}
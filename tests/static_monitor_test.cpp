@@ -0,0 +1,61 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// StaticCpuPerformanceCounter against a fake /proc/stat listing more cores than it samples.
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include "monitors/static_monitor.h"
+#include "test_utils.h"
+
+namespace {
+const std::chrono::milliseconds interval{400};
+
+// user nice system idle iowait irq softirq steal guest guest_nice
+std::string procStat(unsigned long long idle0, unsigned long long idle1, unsigned long long idle2) {
+    return "cpu  300 0 0 " + std::to_string(idle0 + idle1 + idle2) + " 0 0 0 0 0 0\n"
+        + "cpu0 100 0 0 " + std::to_string(idle0) + " 0 0 0 0 0 0\n"
+        + "cpu1 100 0 0 " + std::to_string(idle1) + " 0 0 0 0 0 0\n"
+        + "cpu2 100 0 0 " + std::to_string(idle2) + " 0 0 0 0 0 0\n"
+        + "intr 0\nctxt 0\n";
+}
+}
+
+int main() {
+    test::TempDir root;
+    root.write("proc/stat", procStat(1000, 1000, 1000));
+    const std::string path = root.path() + "/proc/stat";
+
+    // the third core is ignored rather than reported as a change of the number of cores
+    ov::monitor::StaticCpuPerformanceCounter<2> counter{path};
+    double load[2] = {-1, -1};
+    CHECK(counter.sample(load, 2).status == ov::monitor::SampleInfo::NO_DATA);
+    CHECK(counter.sample(load, 1).status == ov::monitor::SampleInfo::BUFFER_TOO_SMALL);
+
+    // the first core is idle half of the time, the second one all the time
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(interval);
+    double ticks = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+        * sysconf(_SC_CLK_TCK);
+    root.write("proc/stat", procStat(1000 + static_cast<unsigned long long>(ticks / 2),
+                                     1000 + static_cast<unsigned long long>(ticks), 1000));
+    ov::monitor::SampleInfo info = counter.sample(load, 2);
+    CHECK(info.status == ov::monitor::SampleInfo::OK);
+    CHECK(info.size == 2);
+    CHECK(load[0] > 0.4 && load[0] < 0.6);
+    CHECK(load[1] > -0.1 && load[1] < 0.1);
+
+    // more cores than the file lists and the system has
+    bool thrown = false;
+    try {
+        ov::monitor::StaticCpuPerformanceCounter<4096> tooWide{path};
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    return test::result();
+}
@@ -0,0 +1,86 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// Checks and fake filesystem trees shared by the tests. A failed check reports itself and makes the test
+// exit with 1 once it has finished.
+
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace test {
+inline int& failures() {
+    static int failed = 0;
+    return failed;
+}
+
+inline int result() {
+    if (failures())
+        std::fprintf(stderr, "%d check(s) failed\n", failures());
+    return failures() ? 1 : 0;
+}
+
+// A temporary directory removed with everything in it at the end of the scope.
+class TempDir {
+public:
+    TempDir() {
+        char path[] = "/tmp/monitors_test.XXXXXX";
+        if (!mkdtemp(path))
+            throw std::runtime_error("mkdtemp() failed");
+        root = path;
+    }
+    ~TempDir() {
+        nftw(root.c_str(), [](const char* path, const struct stat*, int, FTW*) { return std::remove(path); },
+             16, FTW_DEPTH | FTW_PHYS);
+    }
+    TempDir(const TempDir&) = delete;
+    TempDir& operator=(const TempDir&) = delete;
+
+    const std::string& path() const {
+        return root;
+    }
+
+    // Creates the missing parent directories. The file is rewritten in place, so fds opened on it stay valid.
+    void write(const std::string& relativePath, const std::string& content) const {
+        makeParents(relativePath);
+        std::ofstream file{root + "/" + relativePath, std::ios::trunc};
+        file << content;
+    }
+
+    void symlink(const std::string& relativePath, const std::string& target) const {
+        makeParents(relativePath);
+        if (::symlink(target.c_str(), (root + "/" + relativePath).c_str()) != 0)
+            throw std::runtime_error("symlink() failed for " + relativePath);
+    }
+
+    void mkdir(const std::string& relativePath) const {
+        makeParents(relativePath + "/");
+    }
+
+private:
+    void makeParents(const std::string& relativePath) const {
+        for (std::size_t slash = relativePath.find('/'); slash != std::string::npos;
+             slash = relativePath.find('/', slash + 1)) {
+            ::mkdir((root + "/" + relativePath.substr(0, slash)).c_str(), 0755);
+        }
+    }
+
+    std::string root;
+};
+}
+
+#define CHECK(condition)                                                                     \
+    do {                                                                                     \
+        if (!(condition)) {                                                                  \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            ++test::failures();                                                              \
+        }                                                                                    \
+    } while (0)
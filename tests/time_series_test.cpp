@@ -0,0 +1,105 @@
+// Copyright (C) 2019-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// TimeSeriesWriter files written, torn by a crash, reopened and read back.
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "monitors/time_series.h"
+#include "test_utils.h"
+
+namespace {
+const std::size_t width = 2;
+const std::size_t samplesPerBlock = 10;
+
+std::chrono::nanoseconds timestampOf(std::size_t sample) {
+    return std::chrono::milliseconds{1000 + 10 * sample};
+}
+
+void appendSamples(ov::monitor::TimeSeriesWriter& writer, std::size_t from, std::size_t to) {
+    for (std::size_t sample = from; sample < to; ++sample) {
+        double values[width] = {static_cast<double>(sample), sample * 0.5};
+        writer.append(timestampOf(sample), values);
+    }
+}
+
+class ConstantPerformanceCounter : public ov::monitor::PerformanceCounter {
+public:
+    ConstantPerformanceCounter() : ov::monitor::PerformanceCounter("Constant") {}
+    std::vector<double> getLoad() override {
+        return {0.5};
+    }
+};
+}
+
+int main() {
+    test::TempDir root;
+    const std::string path = root.path() + "/series";
+    {
+        ov::monitor::TimeSeriesWriter writer{path, width, std::chrono::milliseconds{1}, samplesPerBlock};
+        appendSamples(writer, 0, 30);
+    }
+    // a crash in the middle of writing the third block
+    long size;
+    {
+        ov::monitor::TimeSeriesReader reader{path};
+        CHECK(reader.getNumberOfBlocks() == 3);
+        CHECK(reader.getNumberOfSamples() == 30);
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        std::fseek(file, 0, SEEK_END);
+        size = std::ftell(file);
+        std::fclose(file);
+    }
+    CHECK(truncate(path.c_str(), size - 5) == 0);
+
+    // the restarted writer drops the torn block and continues after the last complete one
+    {
+        ov::monitor::TimeSeriesWriter writer{path, width, std::chrono::milliseconds{1}, samplesPerBlock};
+        CHECK(writer.getLastTimestamp() == timestampOf(19));
+        appendSamples(writer, 40, 55);
+    }
+    ov::monitor::TimeSeriesReader reader{path};
+    CHECK(reader.getNumberOfBlocks() == 4);
+    CHECK(reader.getNumberOfSamples() == 35);
+    std::vector<std::size_t> samples;
+    bool exact = true;
+    reader.scan(std::chrono::nanoseconds::min(), std::chrono::nanoseconds::max(),
+                [&](std::chrono::nanoseconds timestamp, const double* values) {
+                    std::size_t sample = static_cast<std::size_t>(values[0]);
+                    exact = exact && timestamp == timestampOf(sample) && values[1] == sample * 0.5;
+                    samples.push_back(sample);
+                });
+    CHECK(exact);
+    CHECK(samples.size() == 35);
+    CHECK(!samples.empty() && samples.front() == 0 && samples[19] == 19 && samples[20] == 40
+          && samples.back() == 54);
+
+    // a clock that stepped back doesn't stop archiving: the file already has a sample an hour ahead
+    const std::string archivePath = root.path() + "/archive";
+    auto ahead = std::chrono::system_clock::now().time_since_epoch() + std::chrono::hours{1};
+    {
+        ov::monitor::TimeSeriesWriter writer{archivePath, 1};
+        double value = 0.25;
+        writer.append(ahead, &value);
+    }
+    {
+        ov::monitor::ArchivingPerformanceCounter counter{std::make_shared<ConstantPerformanceCounter>(),
+                                                         archivePath};
+        bool thrown = false;
+        try {
+            CHECK(counter.getLoad().size() == 1);
+            CHECK(counter.getLoad().size() == 1);
+        } catch (const std::logic_error&) {
+            thrown = true;
+        }
+        CHECK(!thrown);
+    }
+    ov::monitor::TimeSeriesReader archive{archivePath};
+    CHECK(archive.getNumberOfSamples() == 3);
+    CHECK(archive.getLastTimestamp() == std::chrono::duration_cast<std::chrono::milliseconds>(ahead));
+    return test::result();
+}